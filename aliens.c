@@ -3,28 +3,73 @@
 
 #include "aliens.h"
 #include <stdlib.h>
+#include <string.h>
 #include <c64/vic.h>
 #include <c64/types.h>
 #include "player.h"
 #include "bases.h"
+#include "bombs.h"
 #include "config.h"
+#include "spritemux.h"
+#if ALIEN_FINE_SCROLL
+#include <c64/rasterirq.h>
+#endif
 
 // --- CONFIGURATION ---
-#define START_ROW       2
 #define START_COL       2
 #define COLLIDE_ROW     23
 #define DROP_ROWS       1
-#define ALIENS_PER_ROW  11
-#define NUM_ROWS        5
 #define MOVEMENT_DELAY  20  
 #define PLAYER_HIT_ROW  22   
 
-#define TOTAL_ALIENS    (NUM_ROWS * ALIENS_PER_ROW)
+// Largest formation a template may ask for. Row masks are 16 bits wide and
+// column masks 8, and every alien index has to fit in a byte.
+#define MAX_ROWS        8
+#define MAX_COLS        12
+#define MAX_ALIENS      (MAX_ROWS * MAX_COLS)
+#define MAX_GRID_WIDTH  40
+#define MAX_GRID_HEIGHT 24
+
+// Rows redrawn per frame in the block march. Larger formations finish the
+// step on the next frame (bottom rows first) instead of overrunning this one.
+// The fine-scroll band needs every row on the frame its XSCROLL resets.
+#if ALIEN_FINE_SCROLL
+#define ROWS_PER_RENDER MAX_ROWS
+#else
+#define ROWS_PER_RENDER 5
+#endif
 
 #define STATE_DEAD       0
 #define STATE_ALIVE      1
 #define STATE_EXPLODING  2
 
+#if ALIEN_FINE_SCROLL
+#if ALIEN_MARCH_RIPPLE
+#error "ALIEN_FINE_SCROLL needs the block march: the band scrolls all rows together"
+#endif
+#endif
+
+#if ALIEN_SPRITE_SURVIVORS
+#if ALIEN_MARCH_RIPPLE
+#error "ALIEN_SPRITE_SURVIVORS needs the block march: the sprites glide with the whole formation"
+#endif
+#if ALIEN_SPRITE_SURVIVORS > MAX_BOMBS - 1 && !SPRITE_MUX
+#error "ALIEN_SPRITE_SURVIVORS borrows bomb sprites and must leave one for the bombs"
+#endif
+#endif
+
+// Pixel glide between march steps, shared by the fine-scroll band and the
+// sprite survivors
+#define ALIEN_GLIDE     (ALIEN_FINE_SCROLL || ALIEN_SPRITE_SURVIVORS)
+
+#if ALIEN_GLIDE
+// The glide carries the formation up to 7 pixels past its grid column, so
+// turn one column earlier on the right to stay inside the 40-column screen.
+#define RIGHT_EDGE_COL   37
+#else
+#define RIGHT_EDGE_COL   38
+#endif
+
 #define EXPLOSION_SPEED  8   // How many frames to stay on each stage (slower = bigger number)
 #define EXPLOSION_BASE   160 // The first character of your explosion set
 
@@ -45,6 +90,11 @@ static const unsigned char ALIEN_CHARS[3][2][2] = {
     { {128, 129}, {134, 135} }
 };
 
+#if ALIEN_SPEEDCODE
+// Unrolled row routines built from ALIEN_CHARS by tools/gen_speedcode.py
+#include "aliens_speedcode.h"
+#endif
+
 // non-linear speed table based on number of alive aliens
 // quadratic ease-in curve formula: speed = 2 + ( (n * n) * 28 ) / (55 * 55);
 static const unsigned char SPEED_TABLE[55] = {
@@ -61,128 +111,829 @@ static const unsigned char SPEED_TABLE[55] = {
     30, 30, 30, 30, 30   
 };
 
-// --- STATE ---
-struct Alien {
-    unsigned char state;    // Changed from 'active'. 0=Dead, 1=Alive, 2=Exploding
-    unsigned char type;
-    unsigned char rel_x;
-    unsigned char rel_y;
-    unsigned char color;
-    unsigned char score_value;
-    unsigned char anim_timer; // Counts the frames between graphic changes
-    unsigned char anim_stage; // Tracks which of the 4 explosion sizes to draw (0-3)
+// --- FORMATION TEMPLATES ---
+// One per wave layout; LEVEL_FORMATION picks the layout for each level and
+// the last entry repeats from then on. Spacing is in cells (aliens are two
+// cells wide and one tall, so col_spacing >= 3 and row_spacing >= 1). The
+// taller waves pack their rows (row_spacing 1) and start lower, so their
+// bottom row starts on the classic wave's and reaches the bases no sooner.
+typedef struct {
+    unsigned char rows;
+    unsigned char cols;
+    unsigned char col_spacing;
+    unsigned char row_spacing;
+    unsigned char start_row;
+    unsigned char row_type[MAX_ROWS];   // alien type (ALIEN_CHARS) of each row
+} formation_template;
+
+static const formation_template FORMATIONS[] = {
+    { 5, 11, 3, 2, 2, { 0, 1, 1, 2, 2 } },              // classic
+    { 6, 11, 3, 1, 5, { 0, 1, 1, 2, 2, 2 } },
+    { 6, 12, 3, 1, 5, { 0, 0, 1, 1, 2, 2 } },
+    { 8, 11, 3, 1, 3, { 0, 0, 1, 1, 1, 2, 2, 2 } }
 };
 
-static struct Alien aliens[TOTAL_ALIENS];
+static const unsigned char LEVEL_FORMATION[] = {
+    0, 0, 1, 1, 2, 2, 3
+};
+
+#define LEVEL_FORMATIONS  (sizeof(LEVEL_FORMATION) / sizeof(LEVEL_FORMATION[0]))
+
+static const unsigned char ROW_COLORS[MAX_ROWS] = {
+    VCOL_LT_RED, VCOL_YELLOW, VCOL_GREEN, VCOL_PURPLE,
+    VCOL_CYAN, VCOL_LT_BLUE, VCOL_ORANGE, VCOL_LT_GREEN
+};
+
+static const unsigned char TYPE_SCORES[3] = {
+    30, 20, 10
+};
+
+// The current formation, unpacked from its template by aliens_load_formation()
+static unsigned char num_rows;
+static unsigned char aliens_per_row;
+static unsigned char total_aliens;
+static unsigned char col_spacing;           // rel_x = c * col_spacing
+static unsigned char row_spacing;           // rel_y = r * row_spacing
+static unsigned char start_row;
+static unsigned char grid_width;
+static unsigned char grid_height;
+static unsigned int  all_cols_mask;
+static unsigned char all_rows_mask;
+
+// Everything fixed per alien comes from its formation row
+static unsigned char row_type[MAX_ROWS];
+static unsigned char row_color[MAX_ROWS];
+static unsigned char row_score[MAX_ROWS];
+static unsigned char row_rel_y[MAX_ROWS];   // r * row_spacing
+static unsigned char col_rel_x[MAX_COLS];   // c * col_spacing
+static unsigned char speed_rank[MAX_ALIENS]; // SPEED_TABLE index for alive_count - 1
+
+// --- STATE ---
+// One byte array per field, indexed by the 8-bit alien index, so every
+// access is a plain absolute,X/Y load.
+static unsigned char alien_state[MAX_ALIENS];     // 0=Dead, 1=Alive, 2=Exploding
+static unsigned char alien_rel_x[MAX_ALIENS];     // column offset from the row's left edge
+
+// --- FORMATION BITMASKS ---
+// Alien (r,c) has index r * aliens_per_row + c.
+// row_alive[r] bit c / col_alive[c] bit r are set while that alien is STATE_ALIVE.
+// row_occupied[r] bit c is set while it is ALIVE or EXPLODING (it still takes
+// up screen space, so it counts for the edge and ground checks).
+static unsigned int  row_alive[MAX_ROWS];
+static unsigned char col_alive[MAX_COLS];
+static unsigned int  row_occupied[MAX_ROWS];
+static unsigned int  alive_cols;        // bit c set while col_alive[c] != 0
+static unsigned char alive_col_count;   // number of bits set in alive_cols
+
+// --- HIT RESOLUTION TABLES ---
+// Map a cell relative to the grid origin straight to a formation row/column
+// (0xFF = gap between aliens). Filled for each formation.
+#define NO_ALIEN        0xFF
+static unsigned char col_from_rel_x[MAX_GRID_WIDTH];
+static unsigned char row_from_rel_y[MAX_GRID_HEIGHT];
+static unsigned char row_first[MAX_ROWS];   // index of alien (r,0)
+
+// --- ROW-SPAN RENDER STATE ---
+// Each formation row is drawn as one contiguous span of cells relative to
+// the grid origin, from its leftmost to its rightmost occupied alien.
+static unsigned char row_lo_col[MAX_ROWS];
+static unsigned char row_span_lo[MAX_ROWS];
+static unsigned char row_span_hi[MAX_ROWS];
+static unsigned char glyph_flip[256];       // alien glyph -> same glyph in the other frame
+
+#if ALIEN_CHARSET_ANIM
+// --- CHARSET ANIMATION ---
+// Screen RAM always holds the frame-0 codes (128..133); the march animates
+// by copying the other frame's glyph definitions over them in Font. Row
+// shifts are then plain copies and an animation-only step writes 48 bytes
+// of charset and nothing else.
+#define SCREEN_FRAME(f)     0
+#define SHIFT_FLIPS         false
+#define ALIEN_GLYPH_FIRST   128
+#define ALIEN_GLYPH_BYTES   (6 * 8)
+static unsigned char alien_glyphs[2][ALIEN_GLYPH_BYTES];   // both frames, captured from Font
+static bool alien_glyphs_captured;
+static unsigned char font_frame;            // frame currently defined in Font
+#else
+#define SCREEN_FRAME(f)     (f)
+#define SHIFT_FLIPS         true
+#endif
+
+// --- PER-ROW POSITION ---
+// Every formation row keeps its own grid position so the rippled march can
+// move one row per frame. grid_x/grid_y in aliens_state is the position the
+// rows are marching to; in the block march all rows reach it in one frame.
+static int row_x[MAX_ROWS];                 // screen column of alien (r,0)
+static int row_y[MAX_ROWS];                 // screen row of alien (r,0)
+static int drawn_x[MAX_ROWS];               // row_x/row_y the row was last drawn at;
+static int drawn_y[MAX_ROWS];               // hits resolve against these
+static unsigned char row_frame[MAX_ROWS];
+static unsigned char drawn_frame[MAX_ROWS];
+
+// --- SCREEN OFFSETS ---
+// grid_base is the Screen offset of alien (0,0) at grid_x/grid_y; it moves
+// by +-1 or +40 with the grid instead of being recomputed. Alien i of row r
+// is drawn at row_base[r] + alien_rel_x[i], and drawn_base[r] is where row
+// r currently sits on screen (the position the next render erases).
+static unsigned short grid_base;
+static unsigned short row_rel_base[MAX_ROWS];  // offset of row r from grid_base
+static unsigned short row_base[MAX_ROWS];
+static unsigned short drawn_base[MAX_ROWS];
+static unsigned char rows_dirty;            // bit r set: row r moved since the last render
+static unsigned char occupied_rows;         // bit r set while row_occupied[r] != 0
+
+// --- EXPLOSION QUEUE ---
+// Aliens in STATE_EXPLODING, packed at the front (unordered). Each entry
+// keeps the screen offset it is drawn at, refreshed when its row moves.
+#define MAX_EXPLOSIONS 16
+static unsigned char exp_alien[MAX_EXPLOSIONS];
+static unsigned char exp_row[MAX_EXPLOSIONS];
+static unsigned short exp_offset[MAX_EXPLOSIONS];
+static unsigned char exp_timer[MAX_EXPLOSIONS];   // frames since the last size change
+static unsigned char exp_stage[MAX_EXPLOSIONS];   // which of the 4 explosion sizes to draw
+static unsigned char exp_count;
+#if ALIEN_MARCH_RIPPLE
+static unsigned char march_rows;            // rows still to move in the current sweep
+#endif
+
+#if ALIEN_GLIDE
+// --- GLIDE ---
+// Between march steps the formation glides 0..7 pixels towards the next
+// step; Screen RAM still only shifts one column per step.
+#define FINE_MAX         7
+static unsigned char fine_x;                // pixels right of the grid column
+static unsigned int  fine_acc;              // 8.8 glide distance this step
+static unsigned int  fine_rate;             // 8.8 pixels per frame, set once per step
+static bool fine_glide;
+static bool fine_rising;                    // glide 0 -> 7 (right) or 7 -> 0 (left)
+#endif
+
+#if ALIEN_FINE_SCROLL
+// --- FINE-SCROLL BAND ---
+// Two raster IRQs bracket the text rows the formation occupies. The first
+// writes $D016 with the formation's XSCROLL (fine_x), the second restores
+// it, so the starfield and bases outside the band stay put.
+#define BAND_FIRST_LINE  51     // raster line of text row 0 (YSCROLL = 3)
+static RIRQCode band_open, band_close;
+static unsigned char band_ctrl2;            // $D016 with XSCROLL cleared
+#endif
+
+#if ALIEN_SPRITE_SURVIVORS
+// --- SPRITE SURVIVORS ---
+// Once the formation is down to ALIEN_SPRITE_SURVIVORS live aliens they
+// leave Screen RAM and are drawn as hardware sprites that follow the glide,
+// so the fast end of a wave moves a pixel at a time. The sprites are bomb
+// sprites 3-6, borrowed by capping the bombs at sprite 2 (bombs_set_limit)
+// until the next wave. The images are built from the alien glyphs into
+// free blocks after the game's own sprites. With SPRITE_MUX they are
+// logical sprites MUX_SURVIVOR_FIRST.. instead and the bombs keep theirs.
+#define SURVIVOR_FIRST_SPRITE   3
+#define SURVIVOR_SPRITE_BLOCK   7       // first free 64-byte block at Sprites
+static bool survivors_built;                // sprite images made from Font
+static bool survivor_mode;
+static unsigned char survivor_count;
+static unsigned char survivor_alien[ALIEN_SPRITE_SURVIVORS];
+static unsigned char survivor_row[ALIEN_SPRITE_SURVIVORS];
+static unsigned char survivor_col[ALIEN_SPRITE_SURVIVORS];
+#endif
+
 // Encapsulated public state (backwards-compatible names live in header macros)
 aliens_state g_aliens_state = { 0 };
 
 // --- LOGIC ---
 
-void aliens_init(void) {
-    aliens_state* a = aliens_get_state();
-    a->alive_count = 0;
-    a->grid_x = START_COL; 
-    a->grid_y = START_ROW;
-    a->dir = 1;
-    a->timer = MOVEMENT_DELAY;
+static unsigned char mask_low_bit(unsigned int m) {
+    unsigned char n = 0;
+    while (!(m & 1)) { m >>= 1; n++; }
+    return n;
+}
+
+static unsigned char mask_high_bit(unsigned int m) {
+    unsigned char n = 0;
+    while (m >>= 1) n++;
+    return n;
+}
+
+// Recompute the cached formation extents from row_occupied[].
+// Only called after a mask changed, never per march step.
+static void aliens_refresh_extents(aliens_state* a) {
+    unsigned int cols = 0;
+    unsigned char rows = 0;
+    for (unsigned char r = 0; r < num_rows; r++) {
+        if (row_occupied[r]) {
+            cols |= row_occupied[r];
+            rows |= (1 << r);
+        }
+    }
+    a->occupied_cols = cols;
+    occupied_rows = rows;
+    for (unsigned char r = 0; r < num_rows; r++) {
+        if (row_occupied[r]) {
+            row_lo_col[r]  = mask_low_bit(row_occupied[r]);
+            row_span_lo[r] = col_rel_x[row_lo_col[r]];
+            row_span_hi[r] = col_rel_x[mask_high_bit(row_occupied[r])] + 1;
+        }
+    }
+    if (cols) {
+        a->left_col   = mask_low_bit(cols);
+        a->right_col  = mask_high_bit(cols);
+        a->bottom_row = mask_high_bit(rows);
+    }
+    a->extents_dirty = 0;
+}
+
+static void aliens_reset_masks(aliens_state* a) {
+    for (unsigned char r = 0; r < num_rows; r++) {
+        row_alive[r] = all_cols_mask;
+        row_occupied[r] = all_cols_mask;
+    }
+    for (unsigned char c = 0; c < aliens_per_row; c++) {
+        col_alive[c] = all_rows_mask;
+    }
+    alive_cols = all_cols_mask;
+    alive_col_count = aliens_per_row;
+    exp_count = 0;
+    a->extents_dirty = 1;
+}
+
+// Bring row r up to the formation's grid position and current frame.
+static void aliens_move_row(aliens_state* a, unsigned char r) {
+    row_x[r] = a->grid_x;
+    row_y[r] = a->grid_y + row_rel_y[r];
+    row_base[r] = grid_base + row_rel_base[r];
+    row_frame[r] = a->anim_frame;
+    rows_dirty |= (1 << r);
     a->render_dirty = 1;
+}
+
+// Mark every row as already drawn where it stands (the caller has just
+// cleared the playfield, so there is nothing to erase).
+static void aliens_sync_drawn(void) {
+    for (unsigned char r = 0; r < num_rows; r++) {
+        drawn_base[r] = row_base[r];
+        drawn_frame[r] = row_frame[r];
+        drawn_x[r] = row_x[r];
+        drawn_y[r] = row_y[r];
+    }
+}
+
+// Finish explosion slot e: blank its cell, release it from the row and
+// drop the slot (the last entry moves into it).
+static void explosion_retire(aliens_state* a, unsigned char e) {
+    unsigned char i = exp_alien[e];
+    unsigned char r = exp_row[e];
+    unsigned short offset = exp_offset[e];
+
+    alien_state[i] = STATE_DEAD;
+
+    // The cell is free now; release it for the edge/ground checks
+    row_occupied[r] &= ~(1u << (i - row_first[r]));
+    a->extents_dirty = 1;
+
+    if (offset < 1000) {
+        Screen[offset]     = 32; // Space
+        Screen[offset + 1] = 32;
+    }
+
+    exp_count--;
+    exp_alien[e] = exp_alien[exp_count];
+    exp_row[e] = exp_row[exp_count];
+    exp_offset[e] = exp_offset[exp_count];
+    exp_timer[e] = exp_timer[exp_count];
+    exp_stage[e] = exp_stage[exp_count];
+}
+
+// Row r has been redrawn at its new position; its explosions follow it.
+static void explosions_follow_row(unsigned char r) {
+    unsigned short base = row_base[r];
+    for (unsigned char e = 0; e < exp_count; e++) {
+        if (exp_row[e] == r) {
+            exp_offset[e] = base + alien_rel_x[exp_alien[e]];
+        }
+    }
+}
+
+// Take alien (r,c) out of the alive masks and start its explosion.
+// Shared by the missile hit and base-collision paths.
+static void alien_start_explosion(aliens_state* a, unsigned char r, unsigned char c) {
+    unsigned char i = row_first[r] + c;
+
+    unsigned short offset = row_base[r] + alien_rel_x[i];
+    if (offset < 1000) {
+        Screen[offset] = ' ';
+        Screen[offset + 1] = ' ';
+    }
+
+    // The row may not have been redrawn at its new position yet
+    unsigned short old_offset = drawn_base[r] + alien_rel_x[i];
+    if (old_offset < 1000) {
+        Screen[old_offset] = ' ';
+        Screen[old_offset + 1] = ' ';
+    }
+
+    alien_state[i] = STATE_EXPLODING;
+
+    // A full queue (a whole row ploughing into the bases) cuts the
+    // explosion with the least time left short rather than losing this
+    // one. Retiring reorders the slots, so find it by its progress.
+    if (exp_count == MAX_EXPLOSIONS) {
+        unsigned char oldest = 0;
+        unsigned char most = 0;
+        for (unsigned char e = 0; e < MAX_EXPLOSIONS; e++) {
+            unsigned char done = exp_stage[e] * EXPLOSION_SPEED + exp_timer[e];
+            if (done > most) {
+                most = done;
+                oldest = e;
+            }
+        }
+        explosion_retire(a, oldest);
+    }
+    exp_alien[exp_count] = i;
+    exp_row[exp_count] = r;
+    exp_offset[exp_count] = offset;
+    exp_timer[exp_count] = 0;
+    exp_stage[exp_count] = 0;
+    exp_count++;
+
+    row_alive[r] &= ~(1u << c);
+    col_alive[c] &= ~(1 << r);
+    if (!col_alive[c]) {
+        alive_cols &= ~(1u << c);
+        alive_col_count--;
+    }
+
+    sfx_alien_hit();
+    a->alive_count--;
+}
 
-    static const unsigned char ROW_COLORS[5] = {
-        VCOL_LT_RED, VCOL_YELLOW, VCOL_GREEN, VCOL_PURPLE, VCOL_CYAN
-    };
+#if ALIEN_CHARSET_ANIM
+static void aliens_set_font_frame(unsigned char f) {
+    memcpy(Font + ALIEN_GLYPH_FIRST * 8, alien_glyphs[f], ALIEN_GLYPH_BYTES);
+    font_frame = f;
+}
+#endif
 
-    static const unsigned char TYPE_SCORES[3] = {
-        30, 20, 10
-    };
+#if ALIEN_FINE_SCROLL
+static void band_init(void) {
+    band_ctrl2 = vic.ctrl2 & 0xF8;
+
+    rirq_build(&band_open, 1);
+    rirq_write(&band_open, 0, &vic.ctrl2, band_ctrl2);
+    rirq_build(&band_close, 1);
+    rirq_write(&band_close, 0, &vic.ctrl2, band_ctrl2);
+
+    rirq_set(IRQ_ALIEN_BAND_OPEN, BAND_FIRST_LINE, &band_open);
+    rirq_set(IRQ_ALIEN_BAND_CLOSE, BAND_FIRST_LINE + 8, &band_close);
+    rirq_sort();
+}
+#endif
+
+#if ALIEN_GLIDE
+// Set up the glide for the step that was just taken. A step right lands on
+// fine_x 0 and a step left on 7, so the screen shift and the glide meet
+// without a jump. While a turn is pending (state 1) the glide holds still.
+// The glide shows on the current_delay frames before the next step; the
+// rate is rounded up so the last of them reaches the far end (7 or 0).
+static void glide_step(aliens_state* a, int moved_x) {
+    if (moved_x > 0) fine_x = 0;
+    else if (moved_x < 0) fine_x = FINE_MAX;
+
+    unsigned char frames = a->current_delay ? a->current_delay : 1;
+    fine_glide = (a->state == 0);
+    fine_rising = (a->dir == 1);
+    fine_acc = 0;
+    fine_rate = ((FINE_MAX << 8) + frames - 1) / frames;
+}
+
+static void glide_update(void) {
+    if (!fine_glide) return;
+    fine_acc += fine_rate;
+    unsigned char px = fine_acc >> 8;
+    if (px > FINE_MAX) px = FINE_MAX;
+    fine_x = fine_rising ? px : FINE_MAX - px;
+}
+#endif
+
+#if ALIEN_FINE_SCROLL
+// Runs in VBlank with the row shifts, so the new XSCROLL and the new
+// Screen RAM columns show up on the same frame.
+static void band_render(bool rows_moved) {
+    rirq_data(&band_open, 0, band_ctrl2 | fine_x);
+
+    if (rows_moved && occupied_rows) {
+        unsigned char top = row_y[mask_low_bit(occupied_rows)];
+        unsigned char bottom = row_y[mask_high_bit(occupied_rows)];
+        rirq_move(IRQ_ALIEN_BAND_OPEN, BAND_FIRST_LINE + top * 8 - 2);
+        rirq_move(IRQ_ALIEN_BAND_CLOSE, BAND_FIRST_LINE + (bottom + 1) * 8);
+        rirq_sort();
+    }
+}
+#endif
+
+void aliens_fine_scroll_reset(void) {
+#if ALIEN_GLIDE
+    fine_x = 0;
+    fine_glide = false;
+#endif
+#if ALIEN_FINE_SCROLL
+    rirq_data(&band_open, 0, band_ctrl2);
+#endif
+}
+
+void aliens_font_reset(void) {
+#if ALIEN_CHARSET_ANIM
+    // Nothing to put back before aliens_init has captured the glyphs
+    if (alien_glyphs_captured && font_frame != 0) {
+        aliens_set_font_frame(0);
+    }
+#endif
+}
+
+#if ALIEN_SPRITE_SURVIVORS
+// Copy each alien glyph pair into the top 8 lines of a hires sprite, one
+// block per type and frame: block = SURVIVOR_SPRITE_BLOCK + type * 2 + frame.
+static void survivors_build(void) {
+    byte* spr = Sprites + SURVIVOR_SPRITE_BLOCK * 64;
+    for (unsigned char t = 0; t < 3; t++) {
+        for (unsigned char f = 0; f < 2; f++) {
+            byte* g0 = Font + ALIEN_CHARS[t][f][0] * 8;
+            byte* g1 = Font + ALIEN_CHARS[t][f][1] * 8;
+            memset(spr, 0, 64);
+            for (unsigned char y = 0; y < 8; y++) {
+                spr[y * 3]     = g0[y];
+                spr[y * 3 + 1] = g1[y];
+            }
+            spr += 64;
+        }
+    }
+    survivors_built = true;
+}
+
+// Give the bomb sprites back and return to drawing the formation as text
+static void survivors_end(void) {
+    for (unsigned char k = 0; k < survivor_count; k++) {
+#if SPRITE_MUX
+        spritemux_hide(MUX_SURVIVOR_FIRST + k);
+#else
+        vic.spr_enable &= ~(1 << (SURVIVOR_FIRST_SPRITE + k));
+#endif
+    }
+    survivor_mode = false;
+    survivor_count = 0;
+#if !SPRITE_MUX
+    bombs_set_limit(MAX_BOMBS);
+#endif
+}
+
+// Called from the render pass. Once few enough aliens are left, hold the
+// bombs to their first sprite; when the borrowed sprites are idle, move the
+// survivors out of Screen RAM onto them. The multiplexer needs no handover.
+static void survivors_begin(void) {
+#if !SPRITE_MUX
+    bombs_set_limit(1);
+    if (!bombs_sprites_idle(1)) return;
+
+    byte* ptrs = Screen + 1016;
+    const byte VIC_BANK_BASE_PTR = (byte)(((unsigned)Sprites - 0x4000) >> 6);
+#endif
+
+    survivor_count = 0;
+    for (unsigned char r = 0; r < num_rows; r++) {
+        unsigned int mask = row_alive[r];
+        for (unsigned char c = 0; mask; c++, mask >>= 1) {
+            if (!(mask & 1)) continue;
+
+            // Release the character cells (the row's last drawn position)
+            unsigned short offset = drawn_base[r] + col_rel_x[c];
+            Screen[offset]     = ' ';
+            Screen[offset + 1] = ' ';
+
+#if !SPRITE_MUX
+            unsigned char s = SURVIVOR_FIRST_SPRITE + survivor_count;
+            ptrs[s] = VIC_BANK_BASE_PTR + SURVIVOR_SPRITE_BLOCK + row_type[r] * 2;
+            vic.spr_color[s] = row_color[r];
+            vic.spr_multi    &= ~(1 << s);
+            vic.spr_expand_x &= ~(1 << s);
+            vic.spr_expand_y &= ~(1 << s);
+#endif
+
+            survivor_alien[survivor_count] = row_first[r] + c;
+            survivor_row[survivor_count] = r;
+            survivor_col[survivor_count] = c;
+            survivor_count++;
+        }
+    }
+    survivor_mode = true;
+}
+
+// Place the survivor sprites at their row's grid position plus the glide
+static void survivors_render(aliens_state* a) {
+#if !SPRITE_MUX
+    byte* ptrs = Screen + 1016;
+#endif
+    const byte VIC_BANK_BASE_PTR = (byte)(((unsigned)Sprites - 0x4000) >> 6);
+
+    for (unsigned char k = 0; k < survivor_count; k++) {
+        unsigned char r = survivor_row[k];
+#if !SPRITE_MUX
+        unsigned char s = SURVIVOR_FIRST_SPRITE + k;
+#endif
+
+        // A hit survivor explodes in character cells like any other alien
+        if (alien_state[survivor_alien[k]] != STATE_ALIVE) {
+#if SPRITE_MUX
+            spritemux_hide(MUX_SURVIVOR_FIRST + k);
+#else
+            vic.spr_enable &= ~(1 << s);
+#endif
+            continue;
+        }
+
+        unsigned int x = (row_x[r] + col_rel_x[survivor_col[k]]) * 8 + 24 + fine_x;
+#if SPRITE_MUX
+        spritemux_set(MUX_SURVIVOR_FIRST + k, x, row_y[r] * 8 + 50,
+                      VIC_BANK_BASE_PTR + SURVIVOR_SPRITE_BLOCK + row_type[r] * 2 + a->anim_frame,
+                      row_color[r], 0);
+#else
+        vic.spr_pos[s].x = x & 0xFF;
+        vic.spr_pos[s].y = row_y[r] * 8 + 50;
+        if (x > 255) {
+            vic.spr_msbx |= (1 << s);
+        } else {
+            vic.spr_msbx &= ~(1 << s);
+        }
+        ptrs[s] = VIC_BANK_BASE_PTR + SURVIVOR_SPRITE_BLOCK + row_type[r] * 2 + a->anim_frame;
+        vic.spr_enable |= (1 << s);
+#endif
+    }
+
+    // Explosions still ride along with their row
+    for (unsigned char e = 0; e < exp_count; e++) {
+        unsigned short offset = row_base[exp_row[e]] + alien_rel_x[exp_alien[e]];
+        if (offset != exp_offset[e]) {
+            if (exp_offset[e] < 1000) {
+                Screen[exp_offset[e]]     = ' ';
+                Screen[exp_offset[e] + 1] = ' ';
+            }
+            exp_offset[e] = offset;
+        }
+    }
+
+    // The rows are not drawn as text any more; keep the drawn position in
+    // step so a hit clears the right cells
+    for (unsigned char r = 0; r < num_rows; r++) {
+        drawn_base[r] = row_base[r];
+        drawn_frame[r] = row_frame[r];
+        drawn_x[r] = row_x[r];
+        drawn_y[r] = row_y[r];
+    }
+    rows_dirty = 0;
+    a->render_full = 0;
+}
+#endif
+
+// Unpack the formation template for the current level and bring every
+// alien in it to life. The per-formation lookup tables are rebuilt here so
+// the per-frame paths never multiply by the spacing.
+static void aliens_load_formation(aliens_state* a) {
+    game_state* gs = game_get_state();
+    unsigned char n = gs->level ? gs->level - 1 : 0;
+    if (n >= LEVEL_FORMATIONS) n = LEVEL_FORMATIONS - 1;
+    const formation_template* f = &FORMATIONS[LEVEL_FORMATION[n]];
+
+    num_rows = f->rows;
+    aliens_per_row = f->cols;
+    col_spacing = f->col_spacing;
+    row_spacing = f->row_spacing;
+    start_row = f->start_row;
+    total_aliens = num_rows * aliens_per_row;
+    grid_width = aliens_per_row * col_spacing;
+    grid_height = num_rows * row_spacing;
+    all_cols_mask = (1u << aliens_per_row) - 1;
+    all_rows_mask = (unsigned char)((1u << num_rows) - 1);
+
+    for (unsigned char c = 0; c < aliens_per_row; c++) {
+        col_rel_x[c] = c * col_spacing;
+    }
+
+    // Scaled to the wave size, so any full wave starts at the slow end of
+    // SPEED_TABLE (the classic 55 map one to one)
+    for (unsigned char k = 0; k < total_aliens; k++) {
+        speed_rank[k] = (unsigned char)((unsigned)k * sizeof(SPEED_TABLE) / total_aliens);
+    }
 
     unsigned char i = 0;
-    
-    for (unsigned char r = 0; r < NUM_ROWS; r++) {
-        unsigned char type;
-        if (r == 0) type = 0;      
-        else if (r < 3) type = 1;  
-        else type = 2;             
-
-        unsigned char row_color = ROW_COLORS[r];
-
-        for (unsigned char c = 0; c < ALIENS_PER_ROW; c++) {
-            if (i >= TOTAL_ALIENS) break; 
-
-            aliens[i].state = STATE_ALIVE;
-            aliens[i].type = type;
-            aliens[i].rel_y = r * 2; 
-            aliens[i].rel_x = c * 3; 
-            aliens[i].color = row_color;
-            aliens[i].score_value = TYPE_SCORES[type];
-            a->alive_count++;
+    for (unsigned char r = 0; r < num_rows; r++) {
+        row_type[r] = f->row_type[r];
+        row_color[r] = ROW_COLORS[r];
+        row_score[r] = TYPE_SCORES[row_type[r]];
+        row_rel_y[r] = r * row_spacing;
+        row_first[r] = i;
+        row_rel_base[r] = row_offsets[row_rel_y[r]];
+
+        for (unsigned char c = 0; c < aliens_per_row; c++) {
+            alien_state[i] = STATE_ALIVE;
+            alien_rel_x[i] = col_rel_x[c];
             i++;
         }
     }
+    a->alive_count = total_aliens;
+
+    // Each alien covers 2 columns of its col_spacing slot and 2 rows of its
+    // row_spacing slot (the missile may hit it at its feet); the rest of a
+    // wider slot is a gap.
+    for (unsigned char x = 0; x < grid_width; x++) {
+        col_from_rel_x[x] = (x % col_spacing < 2) ? x / col_spacing : NO_ALIEN;
+    }
+    for (unsigned char y = 0; y < grid_height; y++) {
+        row_from_rel_y[y] = (y % row_spacing < 2) ? y / row_spacing : NO_ALIEN;
+    }
+
+    rows_dirty = 0;
+}
+
+void aliens_init(void) {
+    aliens_state* a = aliens_get_state();
+    a->grid_x = START_COL; 
+    a->dir = 1;
+    a->timer = MOVEMENT_DELAY;
+
+    // Row shifts flip the animation frame while copying
+    for (unsigned int g = 0; g < 256; g++) {
+        glyph_flip[g] = (unsigned char)g;
+    }
+#if ALIEN_CHARSET_ANIM
+    // Font only holds the pristine frame-0 glyphs until the first swap
+    if (!alien_glyphs_captured) {
+        for (unsigned char t = 0; t < 3; t++) {
+            for (unsigned char k = 0; k < 2; k++) {
+                unsigned char slot = (ALIEN_CHARS[t][0][k] - ALIEN_GLYPH_FIRST) * 8;
+                memcpy(alien_glyphs[0] + slot, Font + ALIEN_CHARS[t][0][k] * 8, 8);
+                memcpy(alien_glyphs[1] + slot, Font + ALIEN_CHARS[t][1][k] * 8, 8);
+            }
+        }
+        alien_glyphs_captured = true;
+    }
+    aliens_set_font_frame(0);
+#else
+    for (unsigned char t = 0; t < 3; t++) {
+        for (unsigned char k = 0; k < 2; k++) {
+            glyph_flip[ALIEN_CHARS[t][0][k]] = ALIEN_CHARS[t][1][k];
+            glyph_flip[ALIEN_CHARS[t][1][k]] = ALIEN_CHARS[t][0][k];
+        }
+    }
+#endif
+#if ALIEN_FINE_SCROLL
+    band_init();
+#endif
+#if ALIEN_SPRITE_SURVIVORS
+    if (!survivors_built) {
+        survivors_build();
+    }
+    survivors_end();
+#endif
+
+    aliens_load_formation(a);
+    aliens_reset_masks(a);
+    aliens_reset_postion(a);
+    aliens_sync_drawn();
 }
 
 static void update_explosions(void) {
     aliens_state* a = aliens_get_state();
-    
-    for (int i = 0; i < TOTAL_ALIENS; i++) {
-        // We only care about aliens currently exploding
-        if (aliens[i].state == STATE_EXPLODING) {
-            
-            // Handle Timing
-            aliens[i].anim_timer++;
-            
-            if (aliens[i].anim_timer >= EXPLOSION_SPEED) {
-                // Time to move to next frame
-                aliens[i].anim_timer = 0;
-                aliens[i].anim_stage++;
-
-                // Check if Explosion is Done
-                if (aliens[i].anim_stage >= 4) {
-                    // Animation finished (0, 1, 2, 3 are done)
-                    aliens[i].state = STATE_DEAD;
-
-                    // Use GRID coordinates to calculate screen pos
-                    int r = a->grid_y + aliens[i].rel_y;
-                    int c = a->grid_x + aliens[i].rel_x;
-                    
-                    int offset = (r * 40) + c;
-                    
-                    if(offset < 1000) {
-                        Screen[offset]     = 32; // Space
-                        Screen[offset + 1] = 32; 
+
+    // Only the queued explosions; idle frames fall straight through
+    unsigned char e = 0;
+    while (e < exp_count) {
+        // Handle Timing
+        exp_timer[e]++;
+
+        if (exp_timer[e] >= EXPLOSION_SPEED) {
+            // Time to move to next frame
+            exp_timer[e] = 0;
+            exp_stage[e]++;
+
+            // Check if Explosion is Done
+            if (exp_stage[e] >= 4) {
+                // Animation finished (0, 1, 2, 3 are done). Slot e now
+                // holds the last entry, so look at it again.
+                explosion_retire(a, e);
+                continue;
+            }
+        }
+
+        //  Draw the Explosion Frame
+        unsigned char current_char = EXPLOSION_BASE + (exp_stage[e] * 2);
+        unsigned short offset = exp_offset[e];
+
+        if (offset < 1000) {
+            // Draw Left half
+            Screen[offset] = current_char;
+            Color[offset]  = VCOL_WHITE;
+
+            // Draw Right half
+            Screen[offset + 1] = current_char + 1;
+            Color[offset + 1]  = VCOL_WHITE;
+        }
+        e++;
+    }
+}
+
+// Base and player collision checks for formation row r after it moved.
+// Returns 1 if an alien reached the player (player_die() has run).
+static int aliens_collide_row(aliens_state* a, unsigned char r) {
+    unsigned int mask = row_alive[r];
+    if (!mask) return 0;
+
+    int alien_y_top = row_y[r];
+
+    // Above the bases there is nothing to hit (the player is lower still)
+    if (alien_y_top + 1 < BASE_TOP_ROW) return 0;
+
+    /* Check for alien collisions with bases. If an alien overlaps a base
+       character its character is destroyed and the alien is removed and
+       the player awarded points. */
+    if (alien_y_top > BASE_BOTTOM_ROW) mask = 0;    // already below them
+    for (unsigned char c = 0; mask; c++, mask >>= 1) {
+        if (!(mask & 1)) continue;
+
+        int alien_x = row_x[r] + col_rel_x[c];
+        bool hit = false;
+
+        /* Aliens occupy two text rows (top and bottom). Check both. */
+        for (int check_row = alien_y_top; check_row <= alien_y_top + 1 && !hit; check_row++) {
+            if (check_row == BASE_TOP_ROW || check_row == BASE_BOTTOM_ROW) {
+                /* Check both left and right character columns */
+                for (int cx = 0; cx <= 1; cx++) {
+                    int col = alien_x + cx;
+                    if (col < 0 || col >= 40) continue;
+                    if (bases_check_hit((unsigned char)col, (unsigned char)check_row, true)) {
+                        /* Start explosion animation (same as missile hit) */
+                        alien_start_explosion(a, r, c);
+                        update_score_display();
+                        hit = true;
+                        break; /* stop checking columns for this alien */
                     }
-                    continue; // Done with this alien
                 }
             }
+        }
+    }
 
-            //  Draw the Explosion Frame
-                int current_char = EXPLOSION_BASE + (aliens[i].anim_stage * 2);
-
-                // Use GRID coordinates to calculate screen pos
-                    int r = a->grid_y + aliens[i].rel_y;
-                    int c = a->grid_x + aliens[i].rel_x;
-            
-            int offset = (r * 40) + c;
-            
-            if(offset < 1000) {
-                // Draw Left half
-                Screen[offset] = current_char;
-                Color[offset]  = VCOL_WHITE; 
-                
-                // Draw Right half
-                Screen[offset + 1] = current_char + 1;
-                Color[offset + 1]  = VCOL_WHITE; 
-            }
+    /* Check for alien collisions with player. If any alien overlaps the
+       player's character, the player dies. */
+    if (alien_y_top < PLAYER_HIT_ROW) return 0;
+
+    player_state* pstate = player_get_state();
+    int p_pixel_x = pstate->player_x;
+    if (p_pixel_x < 24) p_pixel_x = 24;
+
+    int p_col_start = (p_pixel_x - 24) / 8;
+    int p_col_end   = (p_pixel_x - 24 + 23) / 8; 
+
+    mask = row_alive[r];
+    for (unsigned char c = 0; mask; c++, mask >>= 1) {
+        if (!(mask & 1)) continue;
+
+        int alien_x = row_x[r] + col_rel_x[c];
+        int alien_right = alien_x + 1;
+        
+        if (alien_x <= p_col_end && alien_right >= p_col_start) {
+            player_die();
+            return 1;
         }
     }
+    return 0;
 }
 
+#if ALIEN_MARCH_RIPPLE
+// Move the next row of the current sweep, bottom row first like the arcade
+// original. Lower rows go first so a dropping row never overlaps the row
+// below it.
+static void aliens_march_next_row(aliens_state* a) {
+    unsigned char r = mask_high_bit(march_rows);
+    march_rows &= ~(1 << r);
+    aliens_move_row(a, r);
+    aliens_collide_row(a, r);
+}
+#endif
+
 void aliens_update(void) {
     aliens_state* a = aliens_get_state();
     a->old_grid_x = a->grid_x;
     a->old_grid_y = a->grid_y;
 
-    player_state* pstate = player_get_state();
+#if ALIEN_GLIDE
+    glide_update();
+#endif
+
+#if ALIEN_MARCH_RIPPLE
+    // A sweep is in flight: move its next row, keep the step timer running
+    if (march_rows) {
+        if (a->timer > 0) a->timer--;
+        aliens_march_next_row(a);
+        return;
+    }
+#endif
 
     if (a->timer > 0) {
         a->timer--;
@@ -193,7 +944,7 @@ void aliens_update(void) {
 
     // Calculate speed based on level and number of alive aliens
     game_state* gs = game_get_state();
-    int speed_index = a->alive_count - 1 - gs->level;
+    int speed_index = (a->alive_count ? speed_rank[a->alive_count - 1] : 0) - gs->level;
     if (speed_index < 0) {
         speed_index = 0;
     } else if (speed_index > 54) {
@@ -219,28 +970,29 @@ void aliens_update(void) {
     // For debugging
     //g_timer = 56;
 
-    a->render_dirty = 1;       
-
     a->anim_frame ^= 1;
 
+    if (a->extents_dirty) {
+        aliens_refresh_extents(a);
+    }
+
     if (a->state == 0) {
         int min_x = 100;
         int max_x = -100;
         
-        for (unsigned char i = 0; i < TOTAL_ALIENS; i++) {
-            if (!aliens[i].state) continue;
-            
-            int ax = a->grid_x + aliens[i].rel_x;
-            if (ax < min_x) min_x = ax;
-            if (ax > max_x) max_x = ax;
+        // Leftmost/rightmost occupied columns come straight from the masks
+        if (a->occupied_cols) {
+            min_x = a->grid_x + col_rel_x[a->left_col];
+            max_x = a->grid_x + col_rel_x[a->right_col];
         }
 
         if (a->dir == 1) { 
-            if (max_x >= 38) { 
+            if (max_x >= RIGHT_EDGE_COL) { 
                 a->state = 1; 
                 a->next_dir = -1; 
             } else {
                 a->grid_x++;
+                grid_base++;
             }
         } else { 
             if (min_x <= 0) {
@@ -248,149 +1000,279 @@ void aliens_update(void) {
                 a->next_dir = 1; 
             } else {
                 a->grid_x--;
+                grid_base--;
             }
         }
     } 
     else {
         if (a->grid_y < COLLIDE_ROW) {
             a->grid_y += DROP_ROWS;
+            grid_base += DROP_ROWS * 40;
         }
         a->dir = a->next_dir;
         a->state = 0; 
 
-        // Check if ANY active alien has hit the bottom
-           for (unsigned char i = 0; i < TOTAL_ALIENS; i++) {
-               if (!aliens[i].state) continue;
-               int alien_y = a->grid_y + aliens[i].rel_y;
+        // Check if ANY active alien has hit the bottom (only the bottom
+        // occupied row can be the first to get there)
+        if (a->occupied_cols) {
+            int alien_y = a->grid_y + row_rel_y[a->bottom_row];
 
-             if (alien_y >= COLLIDE_ROW) {
-                 // If they hit the ground, the base is lost regardless of lives.
-                 game_over(); 
-                 return; 
-             }
+            if (alien_y >= COLLIDE_ROW) {
+                // If they hit the ground, the base is lost regardless of lives.
+                game_over(); 
+                return; 
+            }
         }
     }
 
-    int p_pixel_x = pstate->player_x;
-    if (p_pixel_x < 24) p_pixel_x = 24;
-
-    int p_col_start = (p_pixel_x - 24) / 8;
-    int p_col_end   = (p_pixel_x - 24 + 23) / 8; 
-
-    /* Check for alien collisions with bases. If an alien overlaps a base
-       character its character is destroyed and the alien is removed and
-       the player awarded points. */
-    for (unsigned char i = 0; i < TOTAL_ALIENS; i++) {
-        if (aliens[i].state != STATE_ALIVE) continue;
-
-        int alien_y_top = a->grid_y + aliens[i].rel_y;
-        int alien_x = a->grid_x + aliens[i].rel_x;
-
-        /* Aliens occupy two text rows (top and bottom). Check both. */
-        for (int check_row = alien_y_top; check_row <= alien_y_top + 1; check_row++) {
-            if (check_row == BASE_TOP_ROW || check_row == BASE_BOTTOM_ROW) {
-                /* Check both left and right character columns */
-                for (int cx = 0; cx <= 1; cx++) {
-                    int col = alien_x + cx;
-                    if (col < 0 || col >= 40) continue;
-                    if (bases_check_hit((unsigned char)col, (unsigned char)check_row, true)) {
-                        /* Start explosion animation (same as missile hit) */
-                        unsigned short r = a->grid_y + aliens[i].rel_y;
-                        unsigned short offset = (r * 40) + a->grid_x + aliens[i].rel_x;
-                        if (offset < 1000) {
-                            Screen[offset] = ' ';
-                            Screen[offset + 1] = ' ';
-                        }
-
-                        unsigned short old_r = a->old_grid_y + aliens[i].rel_y;
-                        unsigned short old_offset = (old_r * 40) + a->old_grid_x + aliens[i].rel_x;
-                        if (old_offset < 1000) {
-                            Screen[old_offset] = ' ';
-                            Screen[old_offset + 1] = ' ';
-                        }
-
-                        aliens[i].state = STATE_EXPLODING;
-                        aliens[i].anim_stage = 0;
-                        aliens[i].anim_timer = 0;
-                        sfx_alien_hit();
-                        a->alive_count--;
-                        a->render_dirty = 1;
-                        update_score_display();
-                        break; /* stop checking columns for this alien */
-                    }
-                }
-            }
-            if (aliens[i].state == STATE_EXPLODING) break;
-        }
+#if ALIEN_MARCH_RIPPLE
+    // Start a new sweep towards the grid position decided above. Every
+    // row reaches it before the next decision, so the edge and drop checks
+    // always see the rows lined up again.
+    march_rows = occupied_rows;
+    if (march_rows) {
+        aliens_march_next_row(a);
+    }
+#else
+#if ALIEN_GLIDE
+    glide_step(a, a->grid_x - a->old_grid_x);
+#endif
+    for (unsigned char r = 0; r < num_rows; r++) {
+        aliens_move_row(a, r);
     }
 
-    /* Check for alien collisions with player. If any alien overlaps the
-       player's character, the player dies. */
-    for (unsigned char i = 0; i < TOTAL_ALIENS; i++) {
-        if (aliens[i].state != STATE_ALIVE) continue;
-
-        int alien_y = a->grid_y + aliens[i].rel_y;
-        int alien_x = a->grid_x + aliens[i].rel_x; 
-
-        if (alien_y >= PLAYER_HIT_ROW) {
-            int alien_right = alien_x + 1;
-            
-            if (alien_x <= p_col_end && alien_right >= p_col_start) {
-                player_die();
-                return;
-            }
-        }
+    // Only the rows reaching down to the bases can hit anything: walk up
+    // from the lowest occupied row and stop at the first one above them.
+    // For most of a level that is the bottom row and it stops at once.
+    if (!a->occupied_cols) return;
+    for (signed char r = a->bottom_row; r >= 0; r--) {
+        if (row_y[r] + 1 < BASE_TOP_ROW) break;
+        if (aliens_collide_row(a, r)) return;
     }
+#endif
 }
 
 // --- RENDER ---
 
-void aliens_render() {
-
-    aliens_state* a = aliens_get_state();
-
-    // Update explosions even if aliens aren't moving (dirty=0)
-    if (!a->render_dirty) {
-        update_explosions();
+// Generic per-alien path for formation row r: clear the old cells of every
+// non-dead alien, then draw the live ones at the row's grid position.
+static void render_row_generic(unsigned char r) {
+#if ALIEN_SPEEDCODE
+    // Same job through the generated routines: constant stores at fixed
+    // offsets from the row base, one mask test per column
+    if (col_spacing == SPEEDCODE_COL_SPACING) {
+        if (drawn_base[r] < 23 * 40) {
+            speed_clear(Screen + drawn_base[r], row_occupied[r]);
+        }
+        if (row_base[r] < 1000) {
+            SPEED_DRAW[row_type[r]][SCREEN_FRAME(row_frame[r])](
+                Screen + row_base[r], Color + row_base[r], row_color[r], row_alive[r]);
+        }
         return;
     }
-    
-    a->render_dirty = 0;
+#endif
 
-    for (unsigned char i = 0; i < TOTAL_ALIENS; i++) {
+    unsigned char first = row_first[r];
+    unsigned char last = first + aliens_per_row;
+
+    for (unsigned char i = first; i < last; i++) {
         // Clearing loop: Clear old positions for ALL non-dead aliens
         // We still need to clear old position for Exploding aliens if the grid moved
-        if (aliens[i].state == STATE_DEAD) continue;
+        if (alien_state[i] == STATE_DEAD) continue;
         
-        unsigned short r = a->old_grid_y + aliens[i].rel_y;
-        if (r >= 23) continue; 
+        // Nothing to clear once the row sits on the ground line
+        if (drawn_base[r] >= 23 * 40) continue;
 
-        // Use safe offset calculation or ensure r < 32
-        unsigned short offset = row_offsets[r] + a->old_grid_x + aliens[i].rel_x;
+        unsigned short offset = drawn_base[r] + alien_rel_x[i];
         
         Screen[offset] = ' '; 
         Screen[offset + 1] = ' ';
     }
 
-    for (unsigned char i = 0; i < TOTAL_ALIENS; i++) {
+    // Every alien in a row shares its type, frame and color
+    unsigned char t = row_type[r];
+    unsigned char g0 = ALIEN_CHARS[t][SCREEN_FRAME(row_frame[r])][0];
+    unsigned char g1 = ALIEN_CHARS[t][SCREEN_FRAME(row_frame[r])][1];
+    unsigned char c = row_color[r];
+
+    for (unsigned char i = first; i < last; i++) {
         // DRAWING loop
         // Do NOT draw normal aliens if they are Exploding.
         // update_explosions handles drawing them.
-        if (aliens[i].state != STATE_ALIVE) continue;
+        if (alien_state[i] != STATE_ALIVE) continue;
 
-        unsigned short r = a->grid_y + aliens[i].rel_y;
-        if (r > 24) continue;
+        if (row_base[r] >= 1000) continue;
 
-        unsigned short offset = row_offsets[r] + a->grid_x + aliens[i].rel_x;
-        unsigned char t = aliens[i].type;
-        
-        Screen[offset]     = ALIEN_CHARS[t][a->anim_frame][0];
-        Screen[offset + 1] = ALIEN_CHARS[t][a->anim_frame][1];
+        unsigned short offset = row_base[r] + alien_rel_x[i];
+        Screen[offset]     = g0;
+        Screen[offset + 1] = g1;
 
-        unsigned char c = aliens[i].color;
         Color[offset]     = c;
         Color[offset + 1] = c;
     }
+}
+
+// Check that row r's span at `p` still holds exactly what the last render
+// left there: the previous glyph pair in every live slot and spaces in the
+// gaps. A star, explosion or base in the span makes this fail.
+static bool row_span_intact(unsigned char r, byte* p) {
+    unsigned char t = row_type[r];
+    unsigned char g0 = ALIEN_CHARS[t][SCREEN_FRAME(drawn_frame[r])][0];
+    unsigned char g1 = ALIEN_CHARS[t][SCREEN_FRAME(drawn_frame[r])][1];
+    unsigned int mask = row_alive[r] >> row_lo_col[r];
+
+    for (unsigned char k = row_span_lo[r]; k <= row_span_hi[r]; k += col_spacing, mask >>= 1) {
+        if (mask & 1) {
+            if (p[k] != g0 || p[k + 1] != g1) return false;
+        } else {
+            if (p[k] != ' ' || p[k + 1] != ' ') return false;
+        }
+        if (k + 2 <= row_span_hi[r] && p[k + 2] != ' ') return false;
+    }
+    return true;
+}
+
+// Fast path for formation row r: each row moves as a rigid block, so
+// move the row's whole span by `delta` (-1, +1 or +40) as one byte loop,
+// flipping the animation frame on the way, and only patch the vacated
+// cells. Returns false without touching the screen if the span is not
+// intact, so the caller can fall back to render_row_generic().
+static bool render_row_shift(unsigned char r, int delta) {
+    if (row_y[r] >= 23) return false;
+
+    byte* src = Screen + drawn_base[r];
+    byte* dst = src + delta;
+    unsigned char lo = row_span_lo[r];
+    unsigned char hi = row_span_hi[r];
+
+    if (!row_span_intact(r, src)) return false;
+
+    if (delta == 40) {
+        // Dropping into the gap row: never wipe a base or anything else
+        for (unsigned char k = lo; k <= hi; k++) {
+            if (dst[k] != ' ') return false;
+        }
+        for (unsigned char k = lo; k <= hi; k++) {
+            dst[k] = glyph_flip[src[k]];
+            src[k] = ' ';
+        }
+    } else if (delta == 1) {
+        for (unsigned char k = hi + 1; k > lo; k--) {
+            dst[k - 1] = glyph_flip[src[k - 1]];
+        }
+        src[lo] = ' ';   // vacated trailing cell
+    } else if (delta == -1) {
+        for (unsigned char k = lo; k <= hi; k++) {
+            dst[k] = glyph_flip[src[k]];
+        }
+        src[hi] = ' ';   // vacated trailing cell
+    } else {
+        // Animation-only step (the formation turned at an edge)
+        for (unsigned char k = lo; k <= hi; k++) {
+            src[k] = glyph_flip[src[k]];
+        }
+        return true;
+    }
+
+    // Every alien in the row shares one color; the gap cells may carry a
+    // stale star color, so repaint the whole new span.
+    byte* col = Color + (dst - Screen);
+    unsigned char c = row_color[r];
+    for (unsigned char k = lo; k <= hi; k++) {
+        col[k] = c;
+    }
+    return true;
+}
+
+// Bring formation row r on screen up to its grid position and frame.
+static void render_row(aliens_state* a, unsigned char r) {
+    unsigned int mask = row_alive[r];
+    int delta = (int)(row_base[r] - drawn_base[r]);
+    bool flipped = SCREEN_FRAME(row_frame[r]) != SCREEN_FRAME(drawn_frame[r]);
+
+    // Rows with an explosion in flight always take the per-alien path.
+    // Anything other than a single march step (a reset, a full redraw
+    // request) does too.
+    if (mask == row_occupied[r] && !a->render_full) {
+        if (!mask || (!delta && !flipped)) goto done;   // nothing to move
+        if (flipped == SHIFT_FLIPS && (delta == 1 || delta == -1 || delta == 40 || delta == 0) &&
+            render_row_shift(r, delta)) goto done;
+    }
+    render_row_generic(r);
+    if (mask != row_occupied[r]) {
+        explosions_follow_row(r);
+    }
+
+done:
+    drawn_base[r] = row_base[r];
+    drawn_frame[r] = row_frame[r];
+    drawn_x[r] = row_x[r];
+    drawn_y[r] = row_y[r];
+}
+
+void aliens_render() {
+
+    aliens_state* a = aliens_get_state();
+
+    // Once the formation is down at the bases its draws and clears land on
+    // base cells, so have the bases repaint theirs on the next frame
+    if (a->occupied_cols && row_y[a->bottom_row] + 1 >= BASE_TOP_ROW) {
+        bases_invalidate();
+    }
+
+#if ALIEN_FINE_SCROLL
+    band_render(a->render_dirty);
+#endif
+
+#if ALIEN_CHARSET_ANIM
+    // The whole formation animates through the charset, in VBlank
+    if (font_frame != a->anim_frame) {
+        aliens_set_font_frame(a->anim_frame);
+    }
+#endif
+
+#if ALIEN_SPRITE_SURVIVORS
+    if (!survivor_mode && a->alive_count && a->alive_count <= ALIEN_SPRITE_SURVIVORS) {
+        survivors_begin();
+    }
+    if (survivor_mode) {
+        survivors_render(a);
+        a->render_dirty = 0;
+        update_explosions();
+        return;
+    }
+#endif
+
+    // Update explosions even if aliens aren't moving (dirty=0)
+    if (!a->render_dirty) {
+        update_explosions();
+        return;
+    }
+    
+    a->render_dirty = 0;
+
+    if (a->extents_dirty) {
+        aliens_refresh_extents(a);
+    }
+
+    // Only rows that moved since the last render (one per frame in the
+    // rippled march, all of them in the block march), bottom row first and
+    // at most ROWS_PER_RENDER of them. A full redraw is never split.
+    if (a->render_full) {
+        for (unsigned char r = 0; r < num_rows; r++) {
+            render_row(a, r);
+        }
+        rows_dirty = 0;
+        a->render_full = 0;
+    } else {
+        for (unsigned char n = 0; rows_dirty && n < ROWS_PER_RENDER; n++) {
+            unsigned char r = mask_high_bit(rows_dirty);
+            rows_dirty &= ~(1 << r);
+            render_row(a, r);
+        }
+        // Rows left over are finished on the next frame
+        if (rows_dirty) a->render_dirty = 1;
+    }
     
     // Update explosions AFTER the clearing/drawing loops.
     // This ensures the explosion is drawn on top and not wiped by the clearing loop.
@@ -400,51 +1282,61 @@ void aliens_render() {
 int aliens_check_hit(unsigned char col, unsigned char row) {
     aliens_state* a = aliens_get_state();
     game_state* gs = game_get_state();
-    if (col < a->grid_x || row < a->grid_y) return 0;
-
-    unsigned char target_rel_x = col - a->grid_x;
-    unsigned char target_rel_y = row - a->grid_y;
-
-    for (unsigned char i = 0; i < TOTAL_ALIENS; i++) {
-        if (aliens[i].state == STATE_DEAD) continue;
-
-        // Check Top Row (rel_y) AND Bottom Row (rel_y + 1)
-        // This ensures the missile hits even if aligned with the alien's feet.
-        if (target_rel_y == aliens[i].rel_y || target_rel_y == aliens[i].rel_y + 1) {
-            
-            if (aliens[i].rel_x == target_rel_x || aliens[i].rel_x + 1 == target_rel_x) {
-                
-                unsigned short r = a->grid_y + aliens[i].rel_y;
-                // Calculate Offset manually to be safe or use expanded table
-                unsigned short offset = (r * 40) + a->grid_x + aliens[i].rel_x;
-                
-                if (offset < 1000) { 
-                    Screen[offset] = ' ';
-                    Screen[offset + 1] = ' ';
-                }
+    // Hits go by what is on screen. A row moved by the march but not yet
+    // redrawn (the rippled march, or a block step split over two renders)
+    // is still one step behind the grid position, so a cell resolves to at
+    // most two candidate rows: one drawn at the grid and one that is not.
+    int target_rel_y = row - a->grid_y;
+    if (target_rel_y < -1 || target_rel_y > grid_height) return 0;
+
+    // An alien drawn in this text row first, then one drawn in the row
+    // above, whose feet the missile may hit (with row_spacing 1 that cell
+    // is the next row's head).
+    unsigned char i = NO_ALIEN;
+    unsigned char r, c;
+    for (unsigned char feet = 0; feet < 2 && i == NO_ALIEN; feet++) {
+        for (int ty = target_rel_y - feet; ty <= target_rel_y + 1 - feet; ty++) {
+            if (ty < 0 || ty >= grid_height) continue;
+            r = row_from_rel_y[ty];
+            if (r == NO_ALIEN || row != drawn_y[r] + feet) continue;
+
+            // The formation is a regular grid, so the cell resolves to at
+            // most one alien slot. Gaps between columns map to NO_ALIEN.
+            int target_rel_x = col - drawn_x[r];
+            if (target_rel_x < 0 || target_rel_x >= grid_width) continue;
+            c = col_from_rel_x[target_rel_x];
+            if (c == NO_ALIEN) continue;
+
+            // Only live aliens can be hit; exploding ones are already out
+            // of the masks
+            if (alien_state[row_first[r] + c] != STATE_ALIVE) continue;
+            i = row_first[r] + c;
+            break;
+        }
+    }
+    if (i == NO_ALIEN) return 0;
 
-                unsigned short old_r = a->old_grid_y + aliens[i].rel_y;
-                unsigned short old_offset = (old_r * 40) + a->old_grid_x + aliens[i].rel_x;
+    alien_start_explosion(a, r, c);
+    gs->score += row_score[r];
 
-                if (old_offset < 1000) { 
-                    Screen[old_offset] = ' ';
-                    Screen[old_offset + 1] = ' ';
-                }
+    update_score_display();
+    return 1; 
+}
 
-                aliens[i].state = STATE_EXPLODING;
-                aliens[i].anim_stage = 0;
-                aliens[i].anim_timer = 0;
-                sfx_alien_hit();
-                a->alive_count--;
-                a->render_dirty = 1;
-                gs->score += aliens[i].score_value;
+int aliens_off_screen(void) {
+#if ALIEN_SPRITE_SURVIVORS
+    return survivor_mode;
+#else
+    return 0;
+#endif
+}
 
-                update_score_display();
-                return 1; 
-            }
-        }
-    }
+unsigned char aliens_fine_x(void) {
+#if ALIEN_GLIDE
+    return fine_x;
+#else
     return 0;
+#endif
 }
 
 int aliens_cleared(void) {
@@ -454,12 +1346,21 @@ int aliens_cleared(void) {
 
 void aliens_reset_postion(aliens_state* a) {
     a->grid_x = START_COL; 
-    a->grid_y = START_ROW;    
-    a->render_dirty = 1;
+    a->grid_y = start_row;    
+    grid_base = row_offsets[start_row] + START_COL;
+#if ALIEN_MARCH_RIPPLE
+    march_rows = 0;
+#endif
+    for (unsigned char r = 0; r < num_rows; r++) {
+        aliens_move_row(a, r);
+    }
+    a->render_full = 1;
+    aliens_fine_scroll_reset();
 }
 
 void aliens_reset(void) {
     aliens_state* a = aliens_get_state();
+    aliens_load_formation(a);
     aliens_reset_postion(a);
     
     a->timer      = 0;
@@ -468,44 +1369,47 @@ void aliens_reset(void) {
     a->next_dir   = 1;  
     a->state      = 0;  
     
-    for (unsigned char i = 0; i < TOTAL_ALIENS; i++) {
-        aliens[i].state = STATE_ALIVE;
-    }
-    a->alive_count = TOTAL_ALIENS;
+    aliens_reset_masks(a);
+
+#if ALIEN_SPRITE_SURVIVORS
+    survivors_end();
+#endif
+
+    // The intro and level screens show the frame-0 glyphs
+    aliens_font_reset();
+
+    // Callers clear the playfield first; don't erase the old rows over
+    // freshly drawn bases
+    aliens_sync_drawn();
 }
 
 // Helper to find a random active alien for bomb dropping
 int aliens_get_random_shooter(int* out_x, int* out_y) {
     aliens_state* a = aliens_get_state();
-    if (a->alive_count == 0) return 0;
-    // Efficient single-pass: determine bottom-most alive alien per column
-    // (columns are spaced by 3 pixels in rel_x: rel_x = col*3).
-    int bottom_idx[ALIENS_PER_ROW];
-    for (int c = 0; c < ALIENS_PER_ROW; c++) bottom_idx[c] = -1;
-
-    for (int i = 0; i < TOTAL_ALIENS; i++) {
-        if (aliens[i].state != STATE_ALIVE) continue;
-        int col = aliens[i].rel_x / 3; // rel_x was initialized as c*3
-        if (col < 0 || col >= ALIENS_PER_ROW) continue; // safety
-        int prev = bottom_idx[col];
-        if (prev == -1 || aliens[i].rel_y > aliens[prev].rel_y) {
-            bottom_idx[col] = i;
+    if (a->alive_count == 0 || alive_col_count == 0) return 0;
+
+    // Pick one of the columns that still has a live alien, then its
+    // bottom-most live alien is the highest bit of that column's mask.
+    unsigned char pick = (unsigned char)(rand() % alive_col_count);
+    unsigned int cols = alive_cols;
+    unsigned char c = 0;
+    for (;;) {
+        if (cols & 1) {
+            if (pick == 0) break;
+            pick--;
         }
+        cols >>= 1;
+        c++;
     }
+    unsigned char r = mask_high_bit(col_alive[c]);
 
-    int shooters[ALIENS_PER_ROW];
-    int sc = 0;
-    for (int c = 0; c < ALIENS_PER_ROW; c++) {
-        if (bottom_idx[c] != -1) shooters[sc++] = bottom_idx[c];
-    }
-
-    if (sc == 0) return 0;
-    int pick = rand() % sc;
-    int idx = shooters[pick];
-
-    // Center the bomb spawn coordinates under the alien
-    *out_x = (a->grid_x + aliens[idx].rel_x) * 8 + 24 - 4; 
-    *out_y = (a->grid_y + aliens[idx].rel_y) * 8 + 50;
+    // Center the bomb spawn coordinates under the alien where it is drawn
+    // (a row the march moved may not be redrawn yet)
+    *out_x = (drawn_x[r] + col_rel_x[c]) * 8 + 24 - 4;
+#if ALIEN_GLIDE
+    *out_x += fine_x;
+#endif
+    *out_y = drawn_y[r] * 8 + 50;
     return 1;
 }
 
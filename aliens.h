@@ -30,8 +30,17 @@ void aliens_render();
 // Returns 1 if hit, 0 if miss. Handles destroying the alien.
 int aliens_check_hit(unsigned char col, unsigned char row);
 
+// Returns 1 while the last aliens are drawn as sprites (ALIEN_SPRITE_SURVIVORS):
+// their cells are blank, so a hit test can't go by the screen code.
+int aliens_off_screen(void);
+
+// Pixels (0-7) the formation is drawn right of its cells: the glide of the
+// fine-scroll band and the sprite survivors. 0 without ALIEN_FINE_SCROLL or
+// ALIEN_SPRITE_SURVIVORS. A hit test shifts its column by this much.
+unsigned char aliens_fine_x(void);
+
 int aliens_cleared(void); // Returns 1 if count is 0
-void aliens_reset(void);  // Resets positions and brings aliens back to life
+void aliens_reset(void);  // Loads the current level's formation, resets positions and brings aliens back to life
 
 /* Encapsulated aliens state */
 typedef struct {
@@ -48,6 +57,14 @@ typedef struct {
 	unsigned char timer;
 	unsigned char current_delay;
 	unsigned char render_dirty;
+	unsigned char render_full;    /* next render redraws every row per alien */
+	/* Formation extents, cached from the per-row/column alive masks in
+	 * aliens.c and only recomputed when an alien leaves the formation. */
+	unsigned int occupied_cols;   /* bit c set if column c has a live or exploding alien */
+	unsigned char left_col;
+	unsigned char right_col;
+	unsigned char bottom_row;
+	unsigned char extents_dirty;
 } aliens_state;
 
 /* Accessor for the state (pointer for pass-by-ref) */
@@ -58,6 +75,14 @@ int aliens_get_random_shooter(int* out_x, int* out_y);
 
 void aliens_reset_postion(aliens_state* a); // Resets only position to starting point
 
+// Put the fine-scroll band back to XSCROLL 0 (no-op unless ALIEN_FINE_SCROLL).
+// Call before drawing full-screen text over the playfield.
+void aliens_fine_scroll_reset(void);
+
+// Put the frame-0 alien glyphs back in Font (no-op unless ALIEN_CHARSET_ANIM).
+// Call before drawing aliens outside the march, e.g. on the intro screen.
+void aliens_font_reset(void);
+
 // Debug
 void aliens_debug_speed(void);
 
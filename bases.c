@@ -21,16 +21,98 @@ static const unsigned char base_bottom_chars[BASE_WIDTH] = {192, 193, 193, 193,
 static unsigned char base_top_stage_chars[BASE_DAMAGE_STAGES][BASE_WIDTH];
 static unsigned char base_bottom_stage_chars[BASE_DAMAGE_STAGES][BASE_WIDTH];
 
-/* Current damage stage for each base cell (0..BASE_DAMAGE_STAGES). */
-static unsigned char base_stage[BASE_COUNT][2][BASE_WIDTH];
+/* Damage stage of each base cell (0..BASE_DAMAGE_STAGES), 2 bits per cell:
+   cell c of base b on row r is bits 2c..2c+1 of base_damage[r][b]. */
+static unsigned int base_damage[2][BASE_COUNT];
+
+/* Cells to repaint on the next bases_render, bit c = cell c. Set when a
+   cell's stage changes or something drew over the base rows. */
+static unsigned char base_dirty[2][BASE_COUNT];
+static bool bases_dirty;
+
+#if BASE_DAMAGE_STAGES > 3
+#error "base damage stages are packed in 2 bits per cell"
+#endif
 
 /* Explicit start columns for the four bases (0-based) as requested */
 static const unsigned char base_starts[BASE_COUNT] = {4, 13, 22, 31};
-static unsigned char base_start_col(unsigned idx) {
-    if (idx >= BASE_COUNT) return 0;
-    return base_starts[idx];
+
+/* Screen column -> base and column within it (BASE_NONE between bases) */
+#define BASE_NONE 0xFF
+static unsigned char col_base[40];
+static unsigned char col_local[40];
+
+static inline unsigned char cell_stage(unsigned int damage, unsigned char c) {
+    return (unsigned char)(damage >> (c * 2)) & 3;
+}
+
+// Put cell c of base b on row r at `stage` and have bases_render repaint it
+static void cell_set_stage(unsigned char r, unsigned char b, unsigned char c, unsigned char stage) {
+    unsigned char shift = c * 2;
+    base_damage[r][b] = (base_damage[r][b] & ~(3u << shift)) | ((unsigned int)stage << shift);
+    base_dirty[r][b] |= 1 << c;
+    bases_dirty = true;
+}
+
+#if BASE_EROSION
+#if BASE_POOL_FIRST <= 200 || BASE_POOL_LAST > 255
+#error "the base glyph pool must lie in the spare codes 201-255"
+#endif
+
+/* Pool glyph each cell shows instead of its stage character, 0 = none.
+   The cell keeps its stage meanwhile, for bases_invalidate and the
+   charclass. */
+static unsigned char base_glyph[2][BASE_COUNT][BASE_WIDTH];
+
+/* Free pool codes, a stack: pool_free[0 .. pool_top - 1] */
+static unsigned char pool_free[BASE_POOL_SIZE];
+static unsigned char pool_top;
+
+#define IMPACT_NONE 8
+
+// Glyph row where a shot covering `pixels` first meets a set pixel, going
+// down from the top or up from the bottom, or IMPACT_NONE.
+static unsigned char impact_row(const byte* glyph, unsigned char pixels, bool from_below) {
+    if (from_below) {
+        for (signed char y = 7; y >= 0; y--) {
+            if (glyph[y] & pixels) return (unsigned char)y;
+        }
+    } else {
+        for (unsigned char y = 0; y < 8; y++) {
+            if (glyph[y] & pixels) return y;
+        }
+    }
+    return IMPACT_NONE;
+}
+
+// Carve a crater into `glyph` from row y on, away from the side the shot
+// came in: a pixel wider than the shot on the impact row, the shot's own
+// columns on the two rows behind it. Returns 1 if nothing is left.
+static int carve_crater(byte* glyph, unsigned char y, unsigned char pixels, bool from_below) {
+    glyph[y] &= ~(pixels | (pixels << 1) | (pixels >> 1));
+    if (from_below) {
+        if (y >= 1) glyph[y - 1] &= ~pixels;
+        if (y >= 2) glyph[y - 2] &= ~pixels;
+    } else {
+        if (y <= 6) glyph[y + 1] &= ~pixels;
+        if (y <= 5) glyph[y + 2] &= ~pixels;
+    }
+
+    unsigned char any = 0;
+    for (unsigned char k = 0; k < 8; k++) any |= glyph[k];
+    return any == 0;
 }
 
+// Return cell c's pool glyph, if it has one, to the pool
+static void cell_free_glyph(unsigned char r, unsigned char b, unsigned char c) {
+    unsigned char code = base_glyph[r][b][c];
+    if (code) {
+        pool_free[pool_top++] = code;
+        base_glyph[r][b][c] = 0;
+    }
+}
+#endif
+
 void bases_init(void) {
     /* Initialize stage character tables.
        Stage 0 = original (new)
@@ -72,12 +154,32 @@ void bases_init(void) {
     base_bottom_stage_chars[2][3] = 199;
     base_bottom_stage_chars[2][4] = 200;
 
+    /* Column lookup for bases_check_hit */
+    memset(col_base, BASE_NONE, sizeof(col_base));
+    for (unsigned char b = 0; b < BASE_COUNT; b++) {
+        for (unsigned char c = 0; c < BASE_WIDTH; c++) {
+            col_base[base_starts[b] + c] = b;
+            col_local[base_starts[b] + c] = c;
+        }
+    }
+
+#if BASE_EROSION
+    /* Every pool glyph free again */
+    memset(base_glyph, 0, sizeof(base_glyph));
+    for (unsigned char i = 0; i < BASE_POOL_SIZE; i++) {
+        pool_free[i] = BASE_POOL_LAST - i;
+    }
+    pool_top = BASE_POOL_SIZE;
+#endif
+
     /* Mark all cells at stage 0 (new) and draw to screen once */
+    bases_dirty = false;
     for (unsigned b = 0; b < BASE_COUNT; b++) {
-        unsigned char sc = base_start_col(b);
+        unsigned char sc = base_starts[b];
         for (unsigned r = 0; r < 2; r++) {
+            base_damage[r][b] = 0;
+            base_dirty[r][b] = 0;
             for (unsigned c = 0; c < BASE_WIDTH; c++) {
-                base_stage[b][r][c] = 0;
                 unsigned short row = (r == 0) ? BASE_TOP_ROW : BASE_BOTTOM_ROW;
                 unsigned short offset = (row * 40) + sc + c;
                 if (offset < 1000) {
@@ -89,56 +191,68 @@ void bases_init(void) {
     }
 }
 
+// Repaint the dirty cells: the cell's pool glyph or stage character, or a
+// blank once destroyed.
+// Nothing to do (one test) while the bases are untouched.
 void bases_render(void) {
-    /* Re-draw bases each frame to ensure they overwrite starfield artifacts */
-    /* Only redraw live base characters so we don't repeatedly write spaces
-       (destruction clears the cell once in bases_check_hit). */
-    for (unsigned b = 0; b < BASE_COUNT; b++) {
-        unsigned char sc = base_start_col(b);
-        for (unsigned c = 0; c < BASE_WIDTH; c++) {
-            unsigned short top_off = (BASE_TOP_ROW * 40) + sc + c;
-            unsigned short bot_off = (BASE_BOTTOM_ROW * 40) + sc + c;
-            /* Top */
-            if (base_stage[b][0][c] < BASE_DAMAGE_STAGES) {
-                unsigned char s = base_stage[b][0][c];
-                if (top_off < 1000) {
-                    Screen[top_off] = base_top_stage_chars[s][c];
-                    Color[top_off]  = VCOL_GREEN;
+    if (!bases_dirty) return;
+    bases_dirty = false;
+
+    for (unsigned char r = 0; r < 2; r++) {
+        unsigned char (*chars)[BASE_WIDTH] = r ? base_bottom_stage_chars : base_top_stage_chars;
+        for (unsigned char b = 0; b < BASE_COUNT; b++) {
+            unsigned char mask = base_dirty[r][b];
+            if (!mask) continue;
+            base_dirty[r][b] = 0;
+
+            unsigned int damage = base_damage[r][b];
+            unsigned short off = (BASE_TOP_ROW + r) * 40 + base_starts[b];
+            for (unsigned char c = 0; mask; c++, mask >>= 1, damage >>= 2) {
+                if (!(mask & 1)) continue;
+                unsigned char stage = (unsigned char)damage & 3;
+                if (stage >= BASE_DAMAGE_STAGES) {
+                    Screen[off + c] = 32;
+                    Color[off + c]  = VCOL_BLACK;
+                } else {
+#if BASE_EROSION
+                    unsigned char code = base_glyph[r][b][c];
+                    Screen[off + c] = code ? code : chars[stage][c];
+#else
+                    Screen[off + c] = chars[stage][c];
+#endif
+                    Color[off + c]  = VCOL_GREEN;
                 }
             }
-            /* Bottom */
-            if (base_stage[b][1][c] < BASE_DAMAGE_STAGES) {
-                unsigned char s = base_stage[b][1][c];
-                if (bot_off < 1000) {
-                    Screen[bot_off] = base_bottom_stage_chars[s][c];
-                    Color[bot_off]  = VCOL_GREEN;
-                }
+        }
+    }
+}
+
+void bases_invalidate(void) {
+    for (unsigned char r = 0; r < 2; r++) {
+        for (unsigned char b = 0; b < BASE_COUNT; b++) {
+            unsigned int damage = base_damage[r][b];
+            unsigned char live = 0;
+            for (unsigned char c = 0; c < BASE_WIDTH; c++, damage >>= 2) {
+                if (((unsigned char)damage & 3) < BASE_DAMAGE_STAGES) live |= 1 << c;
             }
+            base_dirty[r][b] |= live;
         }
     }
+    bases_dirty = true;
 }
 
 int bases_check_hit(unsigned char col, unsigned char row, bool destroy_on_hit) {
     /* Quick bounds check for the rows we care about */
-
     if (row != BASE_TOP_ROW && row != BASE_BOTTOM_ROW) return 0;
+    if (col >= 40) return 0;
 
-    /* Quick bounding check: bases occupy cols 4..35 inclusive */
-    if (col < 4 || col >= 36) return 0; /* outside base region */
+    /* One lookup finds the base and the cell within it */
+    unsigned char b = col_base[col];
+    if (b == BASE_NONE) return 0;
+    unsigned char c = col_local[col];
+    unsigned char r = row - BASE_TOP_ROW;
 
-    /* Determine base index by matching against explicit starts */
-    unsigned idx = 0xFF;
-    for (unsigned i = 0; i < BASE_COUNT; i++) {
-        unsigned sc = base_start_col(i);
-        if (col >= sc && col < sc + BASE_WIDTH) { idx = i; break; }
-    }
-    if (idx == 0xFF) return 0;
-
-    unsigned sc = base_start_col(idx);
-    unsigned local_c = col - sc;
-
-    unsigned row_idx = (row == BASE_TOP_ROW) ? 0 : 1;
-    unsigned char cur_stage = base_stage[idx][row_idx][local_c];
+    unsigned char cur_stage = cell_stage(base_damage[r][b], c);
     if (cur_stage >= BASE_DAMAGE_STAGES) return 0; /* already destroyed */
 
     /* Increment damage stage */
@@ -148,25 +262,61 @@ int bases_check_hit(unsigned char col, unsigned char row, bool destroy_on_hit) {
     else {
         cur_stage++;
     }
-    base_stage[idx][row_idx][local_c] = cur_stage;
-
-    unsigned short offset = (row * 40) + sc + local_c;
-    if (cur_stage >= BASE_DAMAGE_STAGES) {
-        /* Now destroyed: clear cell once */
-        if (offset < 1000) {
-            Screen[offset] = 32;
-            Color[offset]  = VCOL_BLACK;
-        }
-    } else {
-        /* Update the visible damage stage character */
-        if (offset < 1000) {
-            if (row_idx == 0) {
-                Screen[offset] = base_top_stage_chars[cur_stage][local_c];
-            } else {
-                Screen[offset] = base_bottom_stage_chars[cur_stage][local_c];
-            }
-            Color[offset] = VCOL_GREEN;
+#if BASE_EROSION
+    /* A whole-cell hit drops any craters back to the stage characters */
+    cell_free_glyph(r, b, c);
+#endif
+
+    /* The new character (or the blank) goes up on the next bases_render */
+    cell_set_stage(r, b, c, cur_stage);
+    return 1;
+}
+
+int bases_check_hit_at(unsigned char col, unsigned char row, unsigned char pixels, bool from_below) {
+#if BASE_EROSION
+    if (row != BASE_TOP_ROW && row != BASE_BOTTOM_ROW) return 0;
+    if (col >= 40) return 0;
+
+    unsigned char b = col_base[col];
+    if (b == BASE_NONE) return 0;
+    unsigned char c = col_local[col];
+    unsigned char r = row - BASE_TOP_ROW;
+
+    unsigned char stage = cell_stage(base_damage[r][b], c);
+    if (stage >= BASE_DAMAGE_STAGES) return 0;
+
+    /* The glyph on screen: the cell's own, or its stage character's */
+    unsigned char code = base_glyph[r][b][c];
+    if (!code) code = r ? base_bottom_stage_chars[stage][c] : base_top_stage_chars[stage][c];
+    byte* glyph = Font + code * 8;
+
+    unsigned char y = impact_row(glyph, pixels, from_below);
+    if (y == IMPACT_NONE) return 0;   /* through a hole */
+
+    if (!base_glyph[r][b][c]) {
+        if (!pool_top) {
+            /* Pool used up: this cell takes the coarse stages */
+            cell_set_stage(r, b, c, stage + 1);
+            return 1;
         }
+        /* First crater in this cell: give it a copy of its glyph */
+        code = pool_free[--pool_top];
+        byte* own = Font + code * 8;
+        memcpy(own, glyph, 8);
+        glyph = own;
+        base_glyph[r][b][c] = code;
+        base_dirty[r][b] |= 1 << c;
+        bases_dirty = true;
+    }
+
+    /* The glyph is only ever a pool code here, and its Font bytes change
+       on screen at once; an emptied cell goes blank and frees the code */
+    if (carve_crater(glyph, y, pixels, from_below)) {
+        cell_free_glyph(r, b, c);
+        cell_set_stage(r, b, c, BASE_DAMAGE_STAGES);
     }
     return 1;
+#else
+    return bases_check_hit(col, row, false);
+#endif
 }
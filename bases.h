@@ -13,14 +13,37 @@
 #define BASE_TOP_ROW 20   /* Top row index (row 21 visually) */
 #define BASE_BOTTOM_ROW 21 /* Bottom row index (row 22 visually) */
 
+/* Screen codes reserved for eroded cell glyphs (BASE_EROSION); nothing else
+   in the charset uses them */
+#define BASE_POOL_FIRST 201
+#define BASE_POOL_LAST  255
+#define BASE_POOL_SIZE  (BASE_POOL_LAST - BASE_POOL_FIRST + 1)
+
+/* Pixels of a 2 pixel wide shot whose left pixel is column px (0-7) of a
+   cell, bit 7 = leftmost; the right pixel of px 7 is column 0 of the next
+   cell (0x80) */
+#define BASE_SHOT_PIXELS(px) ((unsigned char)(0xC0 >> (px)))
+
 /* Initialize bases for a level */
 void bases_init(void);
 
-/* Called each frame after starfield_render() to draw bases over stars */
+/* Called each frame in VBlank: repaints only the cells that were hit or
+   invalidated since the last call */
 void bases_render(void);
 
-/* Check if a grid cell (col,row) contains a base block. If so, destroy that
-   character and return 1, otherwise return 0. */
+/* Repaint every live base cell on the next bases_render, after something
+   drew over the base rows (the formation reaching them, a cleared screen) */
+void bases_invalidate(void);
+
+/* Check if a grid cell (col,row) contains a base block. If so, damage (or
+   destroy) that character and return 1, otherwise return 0. The screen
+   catches up on the next bases_render. */
 int bases_check_hit(unsigned char col, unsigned char row, bool destroy_on_hit);
 
+/* Same for a bomb or missile whose pixels in the cell are `pixels` (bit 7 =
+   leftmost column), coming from above or, for the missile, from below.
+   With BASE_EROSION it only hits if base pixels are left in those columns
+   and carves a crater there; otherwise it is bases_check_hit. */
+int bases_check_hit_at(unsigned char col, unsigned char row, unsigned char pixels, bool from_below);
+
 #endif /* BASES_H */
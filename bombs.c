@@ -6,15 +6,49 @@
 #include "player.h" 
 #include "config.h"
 #include "bases.h"
+#include "starfield.h"
+#include "collision.h"
+#include "motion.h"
+#include "charclass.h"
 #include <c64/vic.h>
 #include <stdlib.h> 
+#include <string.h>
 
 // --- CONFIGURATION ---
-#define BOMB_SPEED      2       // Pixels per frame        
+#define BOMB_SPEED      2       // Pixels per frame (character layer; sprite bombs follow motion.c)
 #define GROUND_Y        225     // Y position of ground (player row)
 #define FIRST_SPRITE    2       // First bomb uses Sprite 2 (Sprites 0 and 1 are Player and Missile)
+#define BOMB_IMAGE      1       // Sprite block of the bomb art (shared with the missile)
 #define BOMB_COLOR      VCOL_YELLOW
 
+// Character-layer bombs (BOMB_CHAR_LAYER). A bomb is a 2x6 pixel bar in the
+// left two pixel columns of the cell holding the sprite bomb's visible
+// columns, pre-shifted down the cell in BOMB_SPEED steps. Heads 170-173
+// start at pixel row 0/2/4/6; the two lowest overhang the cell below, which
+// shows tail 174 (2 rows) or 175 (4 rows).
+#define BOMB_GLYPH_FIRST    170
+#define BOMB_GLYPH_TAIL     174
+#define BOMB_GLYPH_LAST     175
+#define BOMB_GLYPH_HEIGHT   6
+#define BOMB_GLYPH_BITS     0xC0
+#define BOMB_NO_CELL        0xFFFF
+
+#define PLAYER_TOP_Y        222     // bombs below this are level with the player
+
+// Grid cache markers
+#define BOMB_NO_COL         0xFF
+#define BOMB_NO_ROW         0xFF
+#define BOMB_ALL_SLOTS      ((bomb_mask)~(bomb_mask)0 >> (sizeof(bomb_mask) * 8 - BOMB_SLOTS))
+
+// active[] states
+#define BOMB_FREE           0
+#define BOMB_FALLING        1
+#define BOMB_SPENT          2
+
+#if BOMB_CHAR_LAYER && BOMB_SPEED != 2
+#error "BOMB_CHAR_LAYER glyphs are pre-shifted in 2 pixel steps"
+#endif
+
 // Bomb Spawn Rate - inverse probability (or the "1-in-N chance") of a bomb spawning
 // N / NTSC 60 frames per second is the seconds estimation
 #define BOMB_SPAWN_RATE 50 // 2.0% chance or roughly every 0.8 seconds   
@@ -27,6 +61,78 @@ static bombs_state s_bombs_state = { 0 };
 
 static inline bombs_state* _bstate(void) { return &s_bombs_state; }
 
+#if BOMB_CHAR_LAYER
+// Draw the pre-shifted bomb glyphs into the (RAM) charset.
+static void bombs_build_glyphs(void) {
+    byte* g = Font + BOMB_GLYPH_FIRST * 8;
+    memset(g, 0, (BOMB_GLYPH_LAST - BOMB_GLYPH_FIRST + 1) * 8);
+    for (unsigned char s = 0; s < 4; s++) {
+        for (unsigned char k = 0; k < BOMB_GLYPH_HEIGHT; k++) {
+            unsigned char line = s * BOMB_SPEED + k;
+            if (line < 8) {
+                g[s * 8 + line] = BOMB_GLYPH_BITS;
+            } else {
+                g[(BOMB_GLYPH_TAIL - BOMB_GLYPH_FIRST + s - 2) * 8 + line - 8] = BOMB_GLYPH_BITS;
+            }
+        }
+    }
+}
+
+// Polite erase: only clear the cell if it still shows a bomb glyph.
+static inline void bomb_cell_erase(unsigned int p) {
+    if ((unsigned char)(Screen[p] - BOMB_GLYPH_FIRST) <= BOMB_GLYPH_LAST - BOMB_GLYPH_FIRST) {
+        Screen[p] = ' ';
+    }
+}
+
+// Polite draw: bombs may cover empty space, stars and other bombs, never
+// aliens, bases or text. A star covered this way just disappears until it
+// moves on, the same as behind an alien.
+static inline void bomb_cell_draw(unsigned int p, unsigned char glyph, unsigned char star_base) {
+    unsigned char c = Screen[p];
+    if (c == ' ' || (unsigned char)(c - star_base) <= STAR_FRAMES ||
+        (unsigned char)(c - BOMB_GLYPH_FIRST) <= BOMB_GLYPH_LAST - BOMB_GLYPH_FIRST) {
+        Screen[p] = glyph;
+        Color[p] = BOMB_COLOR;
+    }
+}
+
+// Erase what character bomb i last drew (head and tail).
+static void bomb_char_erase(bombs_state* b, unsigned char i) {
+    unsigned int p = b->char_drawn_pos[i];
+    if (p == BOMB_NO_CELL) return;
+    bomb_cell_erase(p);
+    if (b->char_drawn_glyph[i] >= BOMB_GLYPH_FIRST + 2) {
+        bomb_cell_erase(p + 40);
+    }
+    b->char_drawn_pos[i] = BOMB_NO_CELL;
+}
+
+void bombs_init(void) {
+    // Sprites 2-6 are left alone: bombs live in Screen RAM
+    bombs_state* b = _bstate();
+    b->free = BOMB_ALL_SLOTS;
+    b->spawn_mask = BOMB_ALL_SLOTS;
+    for (unsigned char i = 0; i < BOMB_SLOTS; i++) {
+        // Take any bombs still on screen (lost life, new level) with us
+        if (b->active[i]) bomb_char_erase(b, i);
+        b->active[i] = BOMB_FREE;
+        b->char_drawn_pos[i] = BOMB_NO_CELL;
+    }
+    bombs_build_glyphs();
+}
+#elif SPRITE_MUX
+void bombs_init(void) {
+    // Bombs are logical sprites MUX_BOMB_FIRST.. in the multiplexer pool
+    bombs_state* b = _bstate();
+    b->free = BOMB_ALL_SLOTS;
+    b->spawn_mask = BOMB_ALL_SLOTS;
+    for (unsigned char i = 0; i < MAX_BOMBS; i++) {
+        b->active[i] = BOMB_FREE;
+        spritemux_hide(MUX_BOMB_FIRST + i);
+    }
+}
+#else
 void bombs_init(void) {
     // POINTER SETUP
     // The VIC looks for sprite pointers at the last 8 bytes of Screen RAM.
@@ -41,8 +147,10 @@ void bombs_init(void) {
     if (bomb_ptr == 0) bomb_ptr = 33; 
 
     bombs_state* b = _bstate();
+    b->free = BOMB_ALL_SLOTS;
+    b->spawn_mask = BOMB_ALL_SLOTS;
     for (int i = 0; i < MAX_BOMBS; i++) {
-        b->active[i] = 0;
+        b->active[i] = BOMB_FREE;
         
         // Set Sprite Pointer (Sprite 2, 3, 4, 5, 6)
         // We write to Screen + 1016 + Sprite Index
@@ -61,106 +169,257 @@ void bombs_init(void) {
         vic.spr_msbx &= ~(1 << (FIRST_SPRITE + i));
     }
 }
+#endif
+
+// Take the lowest free slot that new bombs may use (there must be one).
+static unsigned char bomb_take_slot(bombs_state* b) {
+    bomb_mask m = b->free & b->spawn_mask;
+    unsigned char i = 0;
+    while (!(unsigned char)m) {
+        m >>= 8;
+        i += 8;
+    }
+    while (!(m & 1)) {
+        m >>= 1;
+        i++;
+    }
+    b->free &= ~((bomb_mask)1 << i);
+    return i;
+}
+
+// Start a bomb in slot i at sprite position (x, y). A falling bomb never
+// changes column, so its two sample columns (the sprite's visible pixel
+// columns, offsets 11 and 12) are worked out here once.
+static void bomb_spawn(bombs_state* b, unsigned char i, unsigned int x, unsigned int y) {
+    unsigned char col1 = BOMB_NO_COL, col2 = BOMB_NO_COL;
+    if (x >= SCREEN_LEFT_EDGE) {
+        col1 = (unsigned char)((x + 11 - SCREEN_LEFT_EDGE) >> 3);
+        col2 = (unsigned char)((x + 12 - SCREEN_LEFT_EDGE) >> 3);
+        if (col1 >= 40) col1 = BOMB_NO_COL;
+        if (col2 >= 40 || col2 == col1) col2 = BOMB_NO_COL;
+    }
+
+    b->active[i] = BOMB_FALLING;
+    b->x[i] = x;
+    b->y[i] = y;
+    b->col1[i] = col1;
+    b->col2[i] = col2;
+    b->row[i] = BOMB_NO_ROW;
+#if !BOMB_CHAR_LAYER
+    b->frac[i] = 0;
+    b->drawn_y[i] = 0;
+#endif
+    b->next_y[i] = y;                   // first move is a row entry
+
+#if BOMB_CHAR_LAYER
+    // Head cell and glyph for the sprite's visible top pixel (y + 7); the
+    // glyph then steps once per move
+    unsigned int top = y + 7 - SCREEN_TOP_EDGE;
+    b->char_pos[i] = (top >> 3) * 40 + ((x + 12 - SCREEN_LEFT_EDGE) >> 3);
+    b->char_glyph[i] = BOMB_GLYPH_FIRST + ((top & 7) >> 1);
+#endif
+}
+// Retire bomb i. A sprite bomb goes straight back on the free list; a
+// character bomb is erased and freed by the next bombs_render.
+static void bomb_release(bombs_state* b, unsigned char i) {
+#if BOMB_CHAR_LAYER
+    b->active[i] = BOMB_SPENT;
+#else
+    b->active[i] = BOMB_FREE;
+    b->free |= (bomb_mask)1 << i;
+#if SPRITE_MUX
+    spritemux_hide(MUX_BOMB_FIRST + i);
+#else
+    vic.spr_enable &= ~(1 << (FIRST_SPRITE + i));
+#endif
+#endif
+}
+
+// Check a bomb at sprite position (x, y) against the player.
+// Returns 1 (and kills the player) on a hit.
+static int bomb_hit_player(unsigned int x, unsigned int y) {
+    // Player Y Hitbox (Approx 216-231)
+    if (y <= PLAYER_TOP_Y || y >= 231) return 0;
 
-void bombs_update(void) {
-    // SPAWN LOGIC
     player_state* pstate = player_get_state();
-    bombs_state* b = _bstate();
-    if ((rand() % BOMB_SPAWN_RATE) == 0) {
-
-        // There is a maximum number of bombs; find an inactive slot
-        int slot = -1;
-        for (int i = 0; i < MAX_BOMBS; i++) {
-            if (!b->active[i]) {
-                slot = i;
-                break;
+
+    // Use the bomb sprite's visible pixel columns (offsets 11 and 12)
+    // to compute a tight X collision band, and compare against the
+    // player's pixel range (width ~24 pixels).
+    unsigned int bomb_px1 = x + 11;
+    unsigned int bomb_px2 = x + 12;
+
+    int player_left = (int)pstate->player_x;
+    int player_right = player_left + 23; // inclusive end (24 pixels)
+
+    // Collision if any visible bomb pixel intersects player range
+    if (!((int)bomb_px2 < player_left || (int)bomb_px1 > player_right)) {
+        // HIT!
+        player_die();
+        return 1;
+    }
+    return 0;
+}
+
+// Slow path for bomb i, taken when y reaches next_y: its sample point
+// (y + 8, a little below the sprite's top so it stops before overlapping a
+// base) entered a new row, or the bomb is level with the player or the
+// ground. Returns 1 if the bomb is spent.
+static int bomb_event(bombs_state* b, unsigned char i, bool test_player) {
+    unsigned int y = b->y[i];
+    unsigned char row = (unsigned char)((y + 8 - SCREEN_TOP_EDGE) >> 3);
+
+    // Bases are only tested on entering one of their rows: a cell that was
+    // already gone then can't grow back before the bomb leaves it
+    if (row != b->row[i]) {
+        b->row[i] = row;
+        if (row >= BASE_TOP_ROW && row <= BASE_BOTTOM_ROW) {
+            const byte* cells = Screen + row * 40;
+            unsigned char col1 = b->col1[i], col2 = b->col2[i];
+            // The bomb's pixels in col1; col2 only ever holds its right one
+            unsigned char pixels = BASE_SHOT_PIXELS((unsigned char)(b->x[i] + 11 - SCREEN_LEFT_EDGE) & 7);
+            if ((col1 != BOMB_NO_COL && CC_IS_BASE(g_char_class[cells[col1]]) && bases_check_hit_at(col1, row, pixels, false)) ||
+                (col2 != BOMB_NO_COL && CC_IS_BASE(g_char_class[cells[col2]]) && bases_check_hit_at(col2, row, 0x80, false))) {
+                return 1;
             }
         }
-        
-        if (slot != -1) {
-            // Get random alien shooter position
-            int start_x, start_y;
-            if (aliens_get_random_shooter(&start_x, &start_y)) {
-                b->active[slot] = 1;
-                b->x[slot] = start_x;
-                b->y[slot] = start_y;
-                
-                // Turn on Sprite
-                vic.spr_enable |= (1 << (FIRST_SPRITE + slot));
-            }
+    }
+
+    // A. Check Ground Collision
+    if (y > GROUND_Y) return 1;
+
+    // B. Check Player Collision (every frame from here to the ground)
+    if (y > PLAYER_TOP_Y) {
+        if (test_player && bomb_hit_player(b->x[i], y)) return 1;
+        b->next_y[i] = y + 1;
+        return 0;
+    }
+
+    // Sleep until the sample point crosses into the next row
+    unsigned int next = row * 8 + SCREEN_TOP_EDGE;
+    if (next > PLAYER_TOP_Y + 1) next = PLAYER_TOP_Y + 1;
+    b->next_y[i] = next;
+    return 0;
+}
+
+void bombs_update(void) {
+    // SPAWN LOGIC
+    bombs_state* b = _bstate();
+    if ((rand() % BOMB_SPAWN_RATE) == 0 && (b->free & b->spawn_mask)) {
+        // Get random alien shooter position
+        int start_x, start_y;
+        if (aliens_get_random_shooter(&start_x, &start_y)) {
+            unsigned char i = bomb_take_slot(b);
+            bomb_spawn(b, i, start_x, start_y);
+#if !BOMB_CHAR_LAYER && !SPRITE_MUX
+            // Turn on Sprite
+            vic.spr_enable |= (1 << (FIRST_SPRITE + i));
+#endif
         }
     }
 
     // MOVEMENT & COLLISION
-    for (int i = 0; i < MAX_BOMBS; i++) {
-        if (!b->active[i]) continue;
+#if SPRITE_HW_COLLISION && BOMB_CHAR_LAYER
+    // Character bombs are background to the VIC: only test them against
+    // the player if the player sprite touched a character pixel
+    bool test_player = (collision_get_state()->background & COLLIDE_PLAYER) != 0;
+#elif SPRITE_HW_COLLISION
+    // The latches describe the positions shown last frame, so a flagged
+    // player contact is confirmed there, before moving
+    collision_state* c = collision_get_state();
+    bool test_player = false;
+#else
+    bool test_player = true;
+#endif
+#if !BOMB_CHAR_LAYER
+    fix8 vy = motion_get_state()->bomb_vy;
+#endif
+    for (unsigned char i = 0; i < BOMB_SLOTS; i++) {
+        if (b->active[i] != BOMB_FALLING) continue;
+
+#if SPRITE_HW_COLLISION && !BOMB_CHAR_LAYER
+        unsigned char bit = 1 << (FIRST_SPRITE + i);
+        if ((c->sprites & bit) && (c->sprites & COLLIDE_PLAYER) &&
+            bomb_hit_player(b->x[i], b->y[i])) {
+            bomb_release(b, i);
+            continue;
+        }
+#endif
 
         // Move Down
+#if BOMB_CHAR_LAYER
         b->y[i] += BOMB_SPEED;
-
-        /* Check collision with bases (grid conversion).
-           Use a point slightly below the sprite Y to detect earlier
-           (prevents the bomb from overlapping the base char before collision). */
-        {
-            if (b->x[i] >= SCREEN_LEFT_EDGE) {
-                    unsigned int px1 = b->x[i] + 11;
-                    unsigned int px2 = b->x[i] + 12;
-                    int check_pixel_y = b->y[i] + 8; /* sample a point ~mid/bottom of sprite */
-                    int row = (check_pixel_y - SCREEN_TOP_EDGE) / 8;
-                    int col1 = (int)(px1 - SCREEN_LEFT_EDGE) / 8;
-                    int col2 = (int)(px2 - SCREEN_LEFT_EDGE) / 8;
-                    if (row >= 0 && row < 25) {
-                        if ((col1 >= 0 && col1 < 40 && bases_check_hit((unsigned char)col1, (unsigned char)row, false)) ||
-                            (col2 >= 0 && col2 < 40 && bases_check_hit((unsigned char)col2, (unsigned char)row, false))) {
-                            b->active[i] = 0;
-                            vic.spr_enable &= ~(1 << (FIRST_SPRITE + i));
-                            continue;
-                        }
-                }
-            }
+        if (++b->char_glyph[i] > BOMB_GLYPH_FIRST + 3) {
+            b->char_glyph[i] = BOMB_GLYPH_FIRST;
+            b->char_pos[i] += 40;
         }
+#else
+        b->y[i] += motion_step(&b->frac[i], vy);
+#endif
+        if (b->y[i] < b->next_y[i]) continue;
+
+        if (bomb_event(b, i, test_player)) bomb_release(b, i);
+    }
+}
 
-        // A. Check Ground Collision
-        if (b->y[i] > GROUND_Y) {
-            b->active[i] = 0;
-            vic.spr_enable &= ~(1 << (FIRST_SPRITE + i));
+#if BOMB_CHAR_LAYER
+// Runs in VBlank: at most two erases and two draws per bomb, and only for
+// bombs whose cell or shift changed.
+void bombs_render(void) {
+    bombs_state* b = _bstate();
+    unsigned char star_base = starfield_get_state()->char_base;
+    for (unsigned char i = 0; i < BOMB_SLOTS; i++) {
+        unsigned char st = b->active[i];
+        if (st == BOMB_FREE) continue;
+        if (st == BOMB_SPENT) {
+            bomb_char_erase(b, i);
+            b->active[i] = BOMB_FREE;
+            b->free |= (bomb_mask)1 << i;
             continue;
         }
 
-        // B. Check Player Collision
-        // Player Y Hitbox (Approx 216-231)
-        if (b->y[i] > 222 && b->y[i] < 231) {
-
-            // Use the bomb sprite's visible pixel columns (offsets 11 and 12)
-            // to compute a tight X collision band, and compare against the
-            // player's pixel range (width ~24 pixels).
-            unsigned int bomb_px1 = b->x[i] + 11;
-            unsigned int bomb_px2 = b->x[i] + 12;
-
-            int player_left = (int)pstate->player_x;
-            int player_right = player_left + 23; // inclusive end (24 pixels)
-
-            // Collision if any visible bomb pixel intersects player range
-            if (!((int)bomb_px2 < player_left || (int)bomb_px1 > player_right)) {
-                // HIT!
-                b->active[i] = 0;
-                vic.spr_enable &= ~(1 << (FIRST_SPRITE + i));
-                player_die();
-            }
+        unsigned int p = b->char_pos[i];
+        unsigned char g = b->char_glyph[i];
+        if (p == b->char_drawn_pos[i] && g == b->char_drawn_glyph[i]) continue;
+
+        bomb_char_erase(b, i);
+        bomb_cell_draw(p, g, star_base);
+        if (g >= BOMB_GLYPH_FIRST + 2) {
+            bomb_cell_draw(p + 40, BOMB_GLYPH_TAIL + g - (BOMB_GLYPH_FIRST + 2), star_base);
         }
+        b->char_drawn_pos[i] = p;
+        b->char_drawn_glyph[i] = g;
     }
 }
-
+#elif SPRITE_MUX
+void bombs_render(void) {
+    bombs_state* b = _bstate();
+    const byte VIC_BANK_BASE_PTR = (byte)(((unsigned)Sprites - 0x4000) >> 6);
+    for (unsigned char i = 0; i < MAX_BOMBS; i++) {
+        if (!b->active[i]) continue;
+        byte y = (byte)b->y[i];
+        if (!b->drawn_y[i]) {
+            spritemux_set(MUX_BOMB_FIRST + i, b->x[i], y,
+                          VIC_BANK_BASE_PTR + BOMB_IMAGE, BOMB_COLOR, 0);
+        } else if (y != b->drawn_y[i]) {
+            spritemux_move(MUX_BOMB_FIRST + i, b->x[i], y);
+        }
+        b->drawn_y[i] = y;
+    }
+}
+#else
+// Registers are only written when they change: X once per bomb (bombs fall
+// straight down), Y when the whole-pixel position moves.
 void bombs_render(void) {
     bombs_state* b = _bstate();
     for (int i = 0; i < MAX_BOMBS; i++) {
-        if (b->active[i]) {
-            int s = FIRST_SPRITE + i;
-            
-            // Update Hardware Registers
+        if (!b->active[i]) continue;
+        int s = FIRST_SPRITE + i;
+        byte y = (byte)b->y[i];
+
+        if (!b->drawn_y[i]) {
             vic.spr_pos[s].x = b->x[i] & 0xFF;
-            vic.spr_pos[s].y = b->y[i];
-            
+
             // Handle MSB (X > 255)
             // Note: Using spr_msbx as corrected previously
             if (b->x[i] > 255) {
@@ -169,8 +428,29 @@ void bombs_render(void) {
                 vic.spr_msbx &= ~(1 << s);
             }
         }
+        if (y != b->drawn_y[i]) {
+            vic.spr_pos[s].y = y;
+            b->drawn_y[i] = y;
+        }
     }
 }
+#endif
+
+void bombs_set_limit(unsigned char limit) {
+#if !BOMB_CHAR_LAYER
+    // Character bombs don't use sprites, so there is nothing to hand over
+    _bstate()->spawn_mask = (limit >= BOMB_SLOTS) ? BOMB_ALL_SLOTS : (((bomb_mask)1 << limit) - 1);
+#endif
+}
+
+int bombs_sprites_idle(unsigned char first) {
+#if BOMB_CHAR_LAYER
+    return 1;   // no bomb ever uses a sprite
+#else
+    bomb_mask busy = ~_bstate()->free & BOMB_ALL_SLOTS;
+    return (busy >> first) == 0;
+#endif
+}
 
 bombs_state* bombs_get_state(void) {
     return &s_bombs_state;
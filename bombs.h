@@ -17,14 +17,58 @@ void bombs_init(void);
 void bombs_update(void);
 void bombs_render(void);
 
+// Only spawn new bombs on the first `limit` sprites (MAX_BOMBS = all).
+// Bombs already falling on the others are left to land.
+void bombs_set_limit(unsigned char limit);
+
+// Returns 1 if no bomb is falling on sprite slot `first` or above.
+int bombs_sprites_idle(unsigned char first);
+
 // Configuration
+#if SPRITE_MUX
+#include "spritemux.h"
+#define MAX_BOMBS (MUX_SPRITES - MUX_BOMB_FIRST)   /* the rest of the sprite pool */
+#else
 #define MAX_BOMBS 5
+#endif
+#define MAX_CHAR_BOMBS 32   /* bombs in flight at once with BOMB_CHAR_LAYER */
+
+// Bomb slots: one per sprite, or MAX_CHAR_BOMBS on the character layer.
+// bomb_mask has a bit per slot.
+#if BOMB_CHAR_LAYER
+#define BOMB_SLOTS MAX_CHAR_BOMBS
+typedef unsigned long bomb_mask;
+#else
+#define BOMB_SLOTS MAX_BOMBS
+typedef unsigned int bomb_mask;
+#endif
 
 // Encapsulated bombs state
 typedef struct {
-	unsigned char active[MAX_BOMBS];
-	unsigned int  x[MAX_BOMBS];
-	unsigned int  y[MAX_BOMBS];
+	/* 0 = free, 1 = falling, 2 = spent (character layer only: erased by the
+	 * next bombs_render, then freed) */
+	unsigned char active[BOMB_SLOTS];
+	unsigned int  x[BOMB_SLOTS];
+	unsigned int  y[BOMB_SLOTS];
+	/* Grid cache, set at spawn: a falling bomb keeps its columns, and its
+	 * row is only worked out again once y reaches next_y (next row, the
+	 * player or the ground). */
+	unsigned int  next_y[BOMB_SLOTS];
+	unsigned char row[BOMB_SLOTS];
+	unsigned char col1[BOMB_SLOTS];
+	unsigned char col2[BOMB_SLOTS];
+	bomb_mask     free;           /* bit n = slot n free */
+	bomb_mask     spawn_mask;     /* slots new bombs may use (see bombs_set_limit) */
+#if BOMB_CHAR_LAYER
+	/* Head cell and glyph each bomb should show, and what was last drawn */
+	unsigned int  char_pos[BOMB_SLOTS];
+	unsigned char char_glyph[BOMB_SLOTS];
+	unsigned int  char_drawn_pos[BOMB_SLOTS];
+	unsigned char char_drawn_glyph[BOMB_SLOTS];
+#else
+	unsigned char frac[BOMB_SLOTS];     /* sub-pixel part of y (see motion.h) */
+	unsigned char drawn_y[BOMB_SLOTS];  /* Y register last written, 0 = not placed */
+#endif
 } bombs_state;
 
 // Accessor for bombs state
@@ -8,6 +8,8 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "sounds.h"
+#include "spritemux.h"
+#include "motion.h"
 
 // --- CONSTANTS ---
 #define BONUS_SPRITE_INDEX   7        // Reserved 8th sprite
@@ -17,9 +19,6 @@
 #define SCREEN_MIN_X         24
 #define SCREEN_MAX_X         344      
 
-#define BONUS_Y_POS          58     // (50 + 15*1 = 58)
-//#define BONUS_Y_POS          170    // Change position to Row 15 (50 + 15*8 = 170) for testing
-
 #define BONUS_ALIEN_MIN_ROW  4       // Minimum alien row for bonus ship to spawn
 
 #define STATE_OFF            0
@@ -28,13 +27,9 @@
 #define STATE_SHOW_SCORE     3
 
 #define SPAWN_RATE           500     // 1 in N chance per frame to spawn
-#define MOVE_SPEED           1       // Pixels per frame
 #define EXPLOSION_SPEED      20      // Frames per explosion frame
 #define SCORE_SHOW_TIME      150     // Frames to show score after explosion
 
-#define BONUS_ACTIVE_Y_OFFSET   0   // 0 if your ship pixels start at top of sprite
-#define BONUS_ACTIVE_HEIGHT     8   // ship is only 8 pixels tall
-
 // Module state (file-local)
 static bonus_ship_state s_bonus_state = { 0 };
 
@@ -47,10 +42,14 @@ void bonus_init(void) {
     b->state = STATE_OFF;
     b->timer = 0;
     
+#if SPRITE_MUX
+    spritemux_hide(MUX_BONUS);
+#else
     // Ensure Sprite 7 properties are reset
     vic.spr_expand_x &= ~(1 << BONUS_SPRITE_INDEX);
     vic.spr_expand_y &= ~(1 << BONUS_SPRITE_INDEX);
     vic.spr_enable   &= ~(1 << BONUS_SPRITE_INDEX);
+#endif
 
     /* Stop any UFO siren that might still be active (safety for mode switches) */
     sfx_ufo_stop();
@@ -76,6 +75,7 @@ void bonus_update(void) {
             && (rand() % SPAWN_RATE) == 0)  // Random Spawn Success
         {
             b->state = STATE_MOVING;
+            b->frac = 0;
 
             sfx_ufo_start();
 
@@ -91,7 +91,9 @@ void bonus_update(void) {
     }
 
     if (b->state == STATE_MOVING) {
-        b->x += (b->dir * MOVE_SPEED);
+        // Speed from the level's curve (see motion.c)
+        int step = motion_step(&b->frac, motion_get_state()->bonus_vx);
+        b->x += (b->dir * step);
 
         // Bounds Check
         if ((b->dir == 1 && b->x > SCREEN_MAX_X) ||
@@ -166,6 +168,20 @@ void bonus_update(void) {
 
 void bonus_render(void) {
     bonus_ship_state* b = _bstate();
+#if SPRITE_MUX
+    if (b->state == STATE_OFF || b->state == STATE_SHOW_SCORE) {
+        spritemux_hide(MUX_BONUS);
+        return;
+    }
+    {
+        const byte VIC_BANK_BASE_PTR = (byte)(((unsigned)Sprites - 0x4000) >> 6);
+        byte image = (b->state == STATE_MOVING)
+                   ? VIC_BANK_BASE_PTR + BONUS_PTR_OFFSET
+                   : VIC_BANK_BASE_PTR + EXPLOSION_PTR_OFFSET + b->anim_frame;
+        spritemux_set(MUX_BONUS, b->x, BONUS_Y_POS, image, VCOL_RED, MUX_EXPAND_X);
+        return;
+    }
+#endif
     if (b->state == STATE_OFF || b->state == STATE_SHOW_SCORE) {
         vic.spr_enable &= ~(1 << BONUS_SPRITE_INDEX);
         return;
@@ -227,16 +243,7 @@ int bonus_check_hit(int m_col, int m_row)
     if (col_max > 39) col_max = 39;
 
     // Collision band (only the 8-pixel art inside the 21-pixel sprite)
-    int y0 = BONUS_Y_POS + BONUS_ACTIVE_Y_OFFSET;
-    int y1 = y0 + (BONUS_ACTIVE_HEIGHT - 1);
-
-    int row_min = (y0 - SCREEN_TOP_EDGE) / 8;
-    int row_max = (y1 - SCREEN_TOP_EDGE) / 8;
-
-    if (row_min < 0) row_min = 0;
-    if (row_max > 24) row_max = 24;
-
-    if (m_row < row_min || m_row > row_max) return 0;
+    if (m_row < BONUS_ROW_TOP || m_row > BONUS_ROW_BOTTOM) return 0;
     if (m_col < col_min || m_col > col_max) return 0;
 
     // HIT
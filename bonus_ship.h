@@ -12,6 +12,16 @@
 
 #include "config.h"
 
+#define BONUS_Y_POS          58     // (50 + 15*1 = 58)
+//#define BONUS_Y_POS          170    // Change position to Row 15 (50 + 15*8 = 170) for testing
+
+#define BONUS_ACTIVE_Y_OFFSET   0   // 0 if your ship pixels start at top of sprite
+#define BONUS_ACTIVE_HEIGHT     8   // ship is only 8 pixels tall
+
+// Text rows of the ship's collision band: a missile anywhere else can't hit it
+#define BONUS_ROW_TOP       ((BONUS_Y_POS + BONUS_ACTIVE_Y_OFFSET - SCREEN_TOP_EDGE) / 8)
+#define BONUS_ROW_BOTTOM    ((BONUS_Y_POS + BONUS_ACTIVE_Y_OFFSET + BONUS_ACTIVE_HEIGHT - 1 - SCREEN_TOP_EDGE) / 8)
+
 // Initializes the bonus ship system
 void bonus_init(void);
 
@@ -32,6 +42,7 @@ typedef struct {
 	unsigned char state;
 	int x;
 	int dir;
+	unsigned char frac;     /* sub-pixel part of x (see motion.h) */
 	unsigned char timer;
 	unsigned char anim_frame;
 	unsigned int last_score_val;
@@ -0,0 +1,46 @@
+// © 2026 Christopher G Chandler
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "charclass.h"
+#include "starfield.h"
+#include "bases.h"
+
+unsigned char g_char_class[256];
+
+static void charclass_fill(unsigned char first, unsigned char last, unsigned char cls) {
+    for (unsigned int c = first; c <= last; c++) {
+        g_char_class[c] = cls;
+    }
+}
+
+// The ranges below follow the charset layout (see the module that draws
+// each one).
+void charclass_init(void) {
+    charclass_fill(0, 255, CC_EMPTY);
+
+    // Text and digits
+    charclass_fill(0, 127, CC_HUD);
+    g_char_class[' '] = CC_EMPTY;
+    g_char_class[CHAR_GROUND] = CC_GROUND;
+
+    // Aliens (aliens.c: 128-139, the missile has always taken 128-143)
+    charclass_fill(128, 143, CC_ALIEN);
+
+    // Stars (starfield.c: char_base .. char_base + STAR_FRAMES)
+    unsigned char star = starfield_get_state()->char_base;
+    charclass_fill(star, star + STAR_FRAMES, CC_STAR);
+
+    // Alien explosions (aliens.c EXPLOSION_BASE)
+    charclass_fill(160, 167, CC_EXPLOSION);
+
+    // Bases (bases.c stage tables): top 176-184, bottom 192-200, three
+    // codes per stage in each
+    for (unsigned char s = 0; s < BASE_DAMAGE_STAGES; s++) {
+        charclass_fill(176 + s * 3, 178 + s * 3, CC_BASE + s);
+        charclass_fill(192 + s * 3, 194 + s * 3, CC_BASE + s);
+    }
+#if BASE_EROSION
+    // Eroded cells show a glyph from the pool (bases.c)
+    charclass_fill(BASE_POOL_FIRST, BASE_POOL_LAST, CC_BASE);
+#endif
+}
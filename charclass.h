@@ -0,0 +1,35 @@
+// © 2026 Christopher G Chandler
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#ifndef CHARCLASS_H
+#define CHARCLASS_H
+
+/*
+ * charclass.h
+ * Module: Screen code classes
+ * Purpose: One lookup from a Screen RAM code to what the cell holds, so the
+ *          missile and bomb collision tests can reject empty cells and
+ *          stars at once and only call the handler for the class they hit.
+ * Invariants: Call `charclass_init` after `starfield_init` (the star codes
+ *          follow its char base).
+ */
+
+#include "config.h"
+
+// Classes. Bases come last so CC_IS_BASE is one compare.
+#define CC_EMPTY        0   // space and unused codes (incl. bomb glyphs)
+#define CC_STAR         1
+#define CC_ALIEN        2
+#define CC_EXPLOSION    3
+#define CC_GROUND       4
+#define CC_HUD          5   // text and digits
+#define CC_BASE         6   // + damage stage (0 .. BASE_DAMAGE_STAGES - 1; 0 for eroded glyphs)
+
+#define CC_IS_BASE(cls) ((cls) >= CC_BASE)
+
+// Class of each screen code
+extern unsigned char g_char_class[256];
+
+void charclass_init(void);
+
+#endif
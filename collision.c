@@ -0,0 +1,26 @@
+// © 2026 Christopher G Chandler
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "collision.h"
+
+#if SPRITE_HW_COLLISION
+
+#include <c64/vic.h>
+
+#if SPRITE_MUX
+#error "SPRITE_HW_COLLISION needs one hardware sprite per object (SPRITE_MUX 0)"
+#endif
+
+static collision_state s_collision_state = { 0 };
+
+void collision_latch(void) {
+    // Reading a latch clears it for the next frame
+    s_collision_state.sprites = vic.spr_sprcol;
+    s_collision_state.background = vic.spr_backcol;
+}
+
+collision_state* collision_get_state(void) {
+    return &s_collision_state;
+}
+
+#endif
@@ -0,0 +1,35 @@
+// © 2026 Christopher G Chandler
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#ifndef COLLISION_H
+#define COLLISION_H
+
+/*
+ * collision.h
+ * Module: VIC collision latches (SPRITE_HW_COLLISION)
+ * Purpose: Read the sprite-sprite ($D01E) and sprite-background ($D01F)
+ *          latches once per frame, so the exact software tests only run
+ *          for sprites the VIC saw touching something.
+ * Invariants: Call `collision_latch` once at the start of the logic phase.
+ *          The bits describe the frame just shown, i.e. the positions from
+ *          before this frame's movement.
+ */
+
+#include "config.h"
+
+// Hardware sprite bits (fixed allocation, see bombs.c for the bombs)
+#define COLLIDE_PLAYER      0x01
+#define COLLIDE_MISSILE     0x02
+#define COLLIDE_BONUS       0x80
+
+void collision_latch(void);
+
+// Encapsulated latch state (bit n = hardware sprite n)
+typedef struct {
+	unsigned char sprites;      /* touched another sprite */
+	unsigned char background;   /* touched a foreground character pixel */
+} collision_state;
+
+collision_state* collision_get_state(void);
+
+#endif
@@ -62,6 +62,9 @@ extern byte* const Sprites;
 #define SCREEN_LEFT_EDGE    24   // Pixel X of left edge of screen
 #define SCREEN_TOP_EDGE     50   // Pixel Y of top edge of screen
 
+// Ground line character (row 23)
+#define CHAR_GROUND         64
+
 /* Display helpers implemented in `invaders.c` */
 void update_score_display(void);
 void update_lives_display(void);
@@ -96,6 +99,115 @@ void game_over(void);
 #define DEMO_MAX_X 320
 #endif
 
+/* Alien march mode. 0 = block march: the whole formation steps in one
+ * frame. 1 = rippled march: one formation row moves per frame, bottom row
+ * first, like the arcade original, so the per-frame cost is one row.
+ */
+#ifndef ALIEN_MARCH_RIPPLE
+#define ALIEN_MARCH_RIPPLE 0
+#endif
+
+/* Alien fine scroll. 1 = the formation's text rows sit in a raster-IRQ
+ * band with their own $D016 XSCROLL, so the formation glides 1 pixel at a
+ * time between march steps. Needs the block march (ALIEN_MARCH_RIPPLE 0).
+ */
+#ifndef ALIEN_FINE_SCROLL
+#define ALIEN_FINE_SCROLL 0
+#endif
+
+/* Alien animation through the charset. 1 = Screen RAM keeps the frame-0
+ * alien codes and each march step swaps the glyph definitions of the six
+ * alien characters in Font instead of rewriting every alien cell.
+ */
+#ifndef ALIEN_CHARSET_ANIM
+#define ALIEN_CHARSET_ANIM 0
+#endif
+
+/* Sprite survivors. N (1-4) = once only N aliens are left alive they are
+ * drawn as hardware sprites 3-6 (borrowed from the bombs, which fall back to
+ * sprite 2) gliding a pixel at a time instead of as text. 0 = off.
+ */
+#ifndef ALIEN_SPRITE_SURVIVORS
+#define ALIEN_SPRITE_SURVIVORS 0
+#endif
+
+/* Alien row speedcode. 1 = draw and clear formation rows with the unrolled
+ * routines tools/gen_speedcode.py generates into aliens_speedcode.h instead
+ * of the generic per-alien loops. Build with "set ALIEN_SPEEDCODE=1" before
+ * make.bat, which then runs the generator (Python 3) and sets this.
+ */
+#ifndef ALIEN_SPEEDCODE
+#define ALIEN_SPEEDCODE 0
+#endif
+
+/* Character-layer bombs. 1 = alien bombs are drawn as pre-shifted glyphs
+ * in Screen RAM (up to MAX_CHAR_BOMBS at once) instead of on sprites 2-6,
+ * which are then left free. 0 = one hardware sprite per bomb (MAX_BOMBS).
+ */
+#ifndef BOMB_CHAR_LAYER
+#define BOMB_CHAR_LAYER 0
+#endif
+
+/* Sprite multiplexer. 1 = the player, missile, bonus ship, bombs and
+ * sprite survivors are logical sprites in a pool of 16 that spritemux.c
+ * spreads over the 8 hardware sprites with raster IRQs, and MAX_BOMBS
+ * grows to fill the pool. 0 = fixed hardware sprite per object.
+ */
+#ifndef SPRITE_MUX
+#define SPRITE_MUX 0
+#endif
+
+/* Hardware collision. 1 = read the VIC sprite-sprite and sprite-background
+ * latches once per frame and only run the software bomb, missile and bonus
+ * ship tests for sprites the VIC flagged. Needs SPRITE_MUX 0.
+ */
+#ifndef SPRITE_HW_COLLISION
+#define SPRITE_HW_COLLISION 0
+#endif
+
+/* Base erosion. 1 = a base cell gets its own glyph from a pool of spare
+ * screen codes when first hit, and each bomb or missile carves a crater
+ * out of it where it struck; shots pass through the holes. The coarse
+ * damage stages take over when the pool runs out. 0 = damage stages only.
+ */
+#ifndef BASE_EROSION
+#define BASE_EROSION 0
+#endif
+
+/* Charset starfield. 1 = stars sit in fixed cells and fall by rotating the
+ * glyph data of the star characters in Font each motion step, so the
+ * starfield's VBlank cost is the same whatever the number of stars.
+ * 0 = stars move from cell to cell in Screen RAM.
+ */
+#ifndef STARFIELD_CHARSET_ANIM
+#define STARFIELD_CHARSET_ANIM 0
+#endif
+
+/* Adaptive starfield. 1 = time each frame's logic and render work from
+ * the VBlank with CIA 2 timer B and, about once a second, shed stars if the
+ * tightest frame left fewer than STARFIELD_SPARE_LINES lines before the
+ * next VBlank, or add some (up to MAX_STARS) if it left plenty.
+ * 0 = the star count given to starfield_init.
+ */
+#ifndef STARFIELD_ADAPTIVE
+#define STARFIELD_ADAPTIVE 0
+#endif
+#ifndef STARFIELD_SPARE_LINES
+#define STARFIELD_SPARE_LINES 16
+#endif
+
+/* Raster IRQ slots (oscar64 rasterirq) */
+#define IRQ_ALIEN_BAND_OPEN   0
+#define IRQ_ALIEN_BAND_CLOSE  1
+#define IRQ_SPRITE_MUX_FIRST  2   /* MUX_SPRITES - 8 slots */
+
+/* Cycle profiling. 1 = time the per-frame sections with CIA 2 timer A
+ * and show each section's worst case in hex on row 24 (see profile.h).
+ */
+#ifndef PROFILE_ENABLED
+#define PROFILE_ENABLED 0
+#endif
+
 /* Debug info display toggle */
 #ifndef DEBUG_INFO_ENABLED
 #define DEBUG_INFO_ENABLED 0    /* Set to 1 to enable on-screen debug info */
@@ -17,8 +17,16 @@
 #include "bases.h"
 #include "bigfont.h"
 #include "leveldisplay.h"
+#include "profile.h"
+#include "spritemux.h"
+#include "collision.h"
+#include "motion.h"
+#include "charclass.h"
 #include <c64/joystick.h>
 #include <c64/keyboard.h>
+#if ALIEN_FINE_SCROLL || SPRITE_MUX
+#include <c64/rasterirq.h>
+#endif
 
 // Top-level game state is in `game.h` / `game.c` (see `game_get_state()`)
 
@@ -54,7 +62,6 @@ byte* const Color   = (byte*)0xD800;   // Color RAM (not relocatable)
 // --- SCREEN LAYOUT ---
 #define ROW_23_OFFSET   920  // (23 * 40) 
 #define ROW_24_OFFSET   960  // (24 * 40) 
-#define CHAR_GROUND     64
 #define CHAR_LIFE       157
 
 static void vic_set_bank_4000(void)
@@ -198,6 +205,9 @@ static void update_level(void)
 
     Screen[ROW_24_OFFSET + 1] = ones + 48;
     Color[ROW_24_OFFSET + 1]  = VCOL_WHITE;
+
+    // Every level change comes through here: pick up its projectile speeds
+    motion_set_level(gs->level);
 }
 
 /*
@@ -225,6 +235,13 @@ static void resources_init(void)
 
     memcpy(Sprites, all_sprites_data, sizeof(all_sprites_data));
 
+#if ALIEN_FINE_SCROLL || SPRITE_MUX
+    // Raster IRQs for the alien fine-scroll band and the sprite multiplexer
+    // (keep the kernal IRQ chain)
+    rirq_init(true);
+    rirq_start();
+#endif
+
     // IMPORTANT: set sprite pointers (these live at Screen + 0x3F8)
     // Pointers are (sprite_address - bank_base) / 64.
     // Sprites at $6400 in bank $4000 => ($6400-$4000)/64 = $2400/64 = $90.
@@ -275,6 +292,7 @@ static const unsigned char INTRO_BONUS_ROW = 14;
 static const unsigned char INTRO_BONUS_COL = 22;
 
 void game_over(void) {
+    aliens_fine_scroll_reset();
     game_over_sequence();
 
     game_state* gs = game_get_state();
@@ -319,12 +337,22 @@ void game_init(void) {
     resources_init();
     random_init();
     sound_init(); 
+#if PROFILE_ENABLED
+    profile_init();
+#endif
+#if SPRITE_MUX
+    spritemux_init();
+#if PROFILE_ENABLED
+    spritemux_bench();
+#endif
+#endif
 
     update_lives_display();
     update_level();
 
     starfield_init(145, 20); 
     starfield_set_speed(2);          
+    charclass_init();
     
     aliens_init();
     bases_init();
@@ -369,6 +397,11 @@ static void intro_draw(void) {
     // Ensure row 0 score/title is up-to-date
     update_score_display();
 
+    // The intro text must not sit in a scrolled alien band, and its aliens
+    // show frame 0 however the demo left the charset
+    aliens_fine_scroll_reset();
+    aliens_font_reset();
+
     // Clear playfield area (rows 1..22)
     for (int r = 1; r < 23; r++) {
         unsigned short off = r * 40;
@@ -386,6 +419,11 @@ static void intro_draw(void) {
     draw_custom_text(10, 11, "COPYRIGHT (C) 2026", VCOL_CYAN);
     draw_custom_text(12, 13, "CHRIS CHANDLER", VCOL_CYAN);
 
+#if SPRITE_MUX
+    // The intro drives sprite 7 directly: stop the multiplexer's IRQs
+    spritemux_reset();
+#endif
+
     // Bonus ship sprite: enable sprite 7, red, expanded X, positioned center
     // Sprite pointer for bonus in sprites is BASE_SPRITE_PTR + BONUS_PTR_OFFSET (see bonus_ship.c)
     byte* sprite_ptrs = (byte*)(Screen + 1016);
@@ -470,8 +508,14 @@ static void intro_update(void) {
 }
 
 static void intro_render(void) {
+#if STARFIELD_ADAPTIVE
+    starfield_frame_done();
+#endif
     // VBlank
     vic_waitFrame();
+#if STARFIELD_ADAPTIVE
+    starfield_frame_start();
+#endif
 
     // Render starfield
     starfield_render();
@@ -494,8 +538,13 @@ static void game_input(void)
 static void game_update(void)
 {
     // --- LOGIC PHASE ---
+#if SPRITE_HW_COLLISION
+    collision_latch();
+#endif
     starfield_update_motion();
+    PROFILE_BEGIN();
     aliens_update();
+    PROFILE_END(PROFILE_ALIENS_UPDATE);
     missile_update();
     bombs_update();
     bonus_update();
@@ -535,15 +584,41 @@ static void game_update(void)
 static void game_render(void)
 {
     // --- RENDER PHASE ---
+#if STARFIELD_ADAPTIVE
+    // The frame's work ends here: the starfield sizes itself to what's left
+    starfield_frame_done();
+#endif
     vic_waitFrame();
+#if STARFIELD_ADAPTIVE
+    starfield_frame_start();
+#endif
+
+#if SPRITE_MUX
+    // Sprites first: the multiplexer has to load the VIC before the raster
+    // gets back to the top sprite
+    player_render();
+    missile_render();
+    bombs_render();
+    bonus_render();
+    PROFILE_BEGIN();
+    spritemux_sort();
+    PROFILE_END(PROFILE_SPRITE_SORT);
+    PROFILE_BEGIN();
+    spritemux_update();
+    PROFILE_END(PROFILE_SPRITE_UPDATE);
+#endif
 
     starfield_render();
     bases_render();
+    PROFILE_BEGIN();
     aliens_render();
+    PROFILE_END(PROFILE_ALIENS_RENDER);
+#if !SPRITE_MUX
     player_render();
     missile_render();
     bombs_render();
     bonus_render();
+#endif
     draw_ground();
 
 #if DEBUG_INFO_ENABLED
@@ -552,6 +627,10 @@ static void game_render(void)
     game_state* gs = game_get_state();
     draw_custom_text(24, 36, (gs->control == JOYSTICK) ? "J" : "K", VCOL_WHITE);
 #endif
+
+#if PROFILE_ENABLED
+    profile_draw();
+#endif
 }
 
 int main(void)
@@ -642,6 +721,9 @@ int main(void)
                     bombs_init();
                     bonus_init();
 
+                    // screen_init cleared the bases the demo plays on
+                    bases_invalidate();
+
                     vic.spr_expand_x &= ~(1 << 7);
                     vic.spr_enable &= ~(1 << 7);
                     vic.spr_enable |= 1;
@@ -1 +1,8 @@
-call oscar64 invaders.c starfield.c aliens.c player.c missile.c bombs.c bases.c sounds.c gameover.c leveldisplay.c bonus_ship.c bigfont.c game.c player_input.c
+rem ALIEN_SPEEDCODE=1 generates aliens_speedcode.h first, which needs Python 3
+if not defined ALIEN_SPEEDCODE set ALIEN_SPEEDCODE=0
+set SPEEDCODE_OPT=
+if "%ALIEN_SPEEDCODE%"=="1" (
+    python tools\gen_speedcode.py aliens.c aliens_speedcode.h || exit /b 1
+    set SPEEDCODE_OPT=-dALIEN_SPEEDCODE=1
+)
+call oscar64 %SPEEDCODE_OPT% invaders.c starfield.c aliens.c player.c missile.c bombs.c bases.c sounds.c gameover.c leveldisplay.c bonus_ship.c bigfont.c game.c player_input.c profile.c spritemux.c collision.c motion.c charclass.c
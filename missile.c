@@ -11,9 +11,12 @@
 
 #include "config.h"
 #include "bases.h"
+#include "spritemux.h"
+#include "collision.h"
+#include "motion.h"
+#include "charclass.h"
 // --- CONFIGURATION ---
 // Sprite Pointer is defined in config.h (MISSILE_SPRITE_PTR)
-#define MISSILE_SPEED       4   // Pixels per frame
 #define MISSILE_COLOR       VCOL_WHITE
 
 // --- STATE ---
@@ -31,74 +34,145 @@ static unsigned demo_fire_counter = 0;
    false = not pressed last frame, true = pressed last frame */
 static bool prev_fire = false;
 
+// check_grid_cells tests
+#define GRID_TEST_TARGETS     0x01    // bonus ship and aliens (they move: always retest)
+#define GRID_TEST_BASE_BELOW  0x02    // base cell on the row below
+#define GRID_TEST_BASE_ROW    0x04    // base cell on the row itself
+#define GRID_TEST_ALL         (GRID_TEST_TARGETS | GRID_TEST_BASE_BELOW | GRID_TEST_BASE_ROW)
+
+#define MISSILE_ROW_NONE      25      // swept_row before the first test of a shot
+
 // Helper to check a sprite's visible pixels (two columns at offsets 11 and 12)
-// against the text grid. `sprite_x` is the sprite's hardware X (left) coordinate.
-// Returns 1 if hit, 0 if miss.
-static int check_grid_hit_from_sprite(unsigned int sprite_x, unsigned int pixel_y) {
+// on text row `row`. `sprite_x` is the sprite's hardware X (left) coordinate
+// and `tests` picks the GRID_TEST_* checks. Returns 1 if hit, 0 if miss.
+static int check_grid_cells(unsigned int sprite_x, unsigned char row, unsigned char tests) {
 
     // convert both visible sprite pixel columns (11 and 12 within sprite)
     unsigned int px1 = sprite_x + 11;
     unsigned int px2 = sprite_x + 12;
 
     // Boundary Checks (use right-most pixel)
-    if (px2 < SCREEN_LEFT_EDGE || pixel_y < SCREEN_TOP_EDGE) return 0;
+    if (px2 < SCREEN_LEFT_EDGE || row >= 25) return 0;
 
     // Convert Pixel to Grid for both pixels
     int col1 = (int)(px1 - SCREEN_LEFT_EDGE) / 8;
     int col2 = (int)(px2 - SCREEN_LEFT_EDGE) / 8;
-    int row  = (int)(pixel_y - SCREEN_TOP_EDGE) / 8;
 
-    // Validate row
-    if (row < 0 || row >= 25) return 0;
-
-    // Check both columns (they may map to same column)
+    // Check both columns (they may map to same column). The base tests
+    // take the missile's pixels within the cell.
     int cols[2] = { col1, col2 };
+    // The formation is drawn aliens_fine_x() pixels right of its cells
+    unsigned char fine = aliens_fine_x();
+    int alien_px[2] = { (int)px1 - SCREEN_LEFT_EDGE - fine, (int)px2 - SCREEN_LEFT_EDGE - fine };
+    unsigned char px = (unsigned char)(px1 - SCREEN_LEFT_EDGE) & 7;
+    unsigned char pixels[2] = { BASE_SHOT_PIXELS(px), px == 7 ? 0x80 : BASE_SHOT_PIXELS(px) };
     for (int i = 0; i < 2; i++) {
         int col = cols[i];
         if (col < 0 || col >= 40) continue;
 
-        unsigned char char_code = Screen[row * 40 + col];
-
-        // Bonus ship is a sprite, not in Screen RAM
-        if (bonus_check_hit((unsigned char)col, (unsigned char)row) != 0) {
-            return 1;
-        }
+        // One read and one lookup tell what the cell holds
+        unsigned int p = row * 40 + col;
+        unsigned char cls = g_char_class[Screen[p]];
+
+        if (tests & GRID_TEST_TARGETS) {
+            // Bonus ship is a sprite, not in Screen RAM: only its own rows
+            if (row >= BONUS_ROW_TOP && row <= BONUS_ROW_BOTTOM
+#if SPRITE_HW_COLLISION
+                // ...and only if the VIC saw the two sprites touch
+                && (collision_get_state()->sprites & (COLLIDE_MISSILE | COLLIDE_BONUS)) == (COLLIDE_MISSILE | COLLIDE_BONUS)
+#endif
+                && bonus_check_hit((unsigned char)col, row) != 0) {
+                return 1;
+            }
 
-        // Check for Alien (Range 128-143)
-        if (char_code >= 128 && char_code <= 143) {
-            if (aliens_check_hit((unsigned char)col, (unsigned char)row)) {
-                return 1; // Real hit confirmed
+            // Check for Alien, in the cell drawn under the missile
+            if (alien_px[i] >= 0) {
+                int acol = alien_px[i] >> 3;
+                unsigned char acls = (acol == col) ? cls : g_char_class[Screen[p - col + acol]];
+                if (acls == CC_ALIEN || aliens_off_screen()) {
+                    if (aliens_check_hit((unsigned char)acol, row)) {
+                        return 1; // Real hit confirmed
+                    }
+                }
             }
         }
 
         // Prefer hitting the lower base cell first (missile travels up).
         // If a base exists on the row below, damage that first.
-        int lower_row = row + 1;
-        if (lower_row < 25) {
-            if (bases_check_hit((unsigned char)col, (unsigned char)lower_row, false)) {
+        unsigned char lower_row = row + 1;
+        if ((tests & GRID_TEST_BASE_BELOW) && lower_row < 25 && CC_IS_BASE(g_char_class[Screen[p + 40]])) {
+            if (bases_check_hit_at((unsigned char)col, lower_row, pixels[i], true)) {
                 return 1;
             }
         }
 
         // Then check the computed row
-        if (bases_check_hit((unsigned char)col, (unsigned char)row, false)) {
+        if ((tests & GRID_TEST_BASE_ROW) && CC_IS_BASE(cls) && bases_check_hit_at((unsigned char)col, row, pixels[i], true)) {
             return 1;
         }
     }
     return 0;
 }
 
+// All tests for the cells at pixel row `pixel_y`. Returns 1 if hit, 0 if miss.
+static int check_grid_hit_from_sprite(unsigned int sprite_x, unsigned int pixel_y) {
+    if (pixel_y < SCREEN_TOP_EDGE) return 0;
+    return check_grid_cells(sprite_x, (unsigned char)((pixel_y - SCREEN_TOP_EDGE) >> 3), GRID_TEST_ALL);
+}
+
+#if !SPRITE_HW_COLLISION
+// The tip and body tests of check_grid_hit_from_sprite, swept: the same
+// tests in the same order, minus those that can't have changed. Bases only
+// ever lose cells and the missile only climbs, so every base row from
+// m->swept_row down was tested (and missed) on an earlier frame. The bonus
+// ship and the aliens move, so their cells are retested every frame, but
+// only once when the tip and body share a row. Returns 1 if hit.
+static int check_grid_swept(missile_state* m) {
+    unsigned int visual_y = m->y + 7;
+    unsigned char swept = m->swept_row;
+    unsigned char tip = MISSILE_ROW_NONE;
+
+    // Check Tip (Top pixel)
+    if (visual_y >= SCREEN_TOP_EDGE) {
+        tip = (unsigned char)((visual_y - SCREEN_TOP_EDGE) >> 3);
+        unsigned char tests = GRID_TEST_TARGETS;
+        if (tip + 1 < swept) tests |= GRID_TEST_BASE_BELOW;
+        if (tip < swept) tests |= GRID_TEST_BASE_ROW;
+        if (check_grid_cells(m->x, tip, tests)) return 1;
+    }
+
+    // Check Body (length of missile pixels down) to prevent tunnelling. It
+    // is on the tip's row or the one below, already base-tested by the tip.
+    unsigned char body = (unsigned char)((visual_y + 7 - SCREEN_TOP_EDGE) >> 3);
+    if (body != tip) {
+        unsigned char tests = GRID_TEST_TARGETS;
+        if (body + 1 < swept) tests |= GRID_TEST_BASE_BELOW;
+        if (body < swept && body != tip + 1) tests |= GRID_TEST_BASE_ROW;
+        if (check_grid_cells(m->x, body, tests)) return 1;
+    }
+
+    m->swept_row = (tip < body) ? tip : body;
+    return 0;
+}
+#endif
+
 // --- PUBLIC API ---
 
 void missile_init(void) {
     missile_state* m = _mstate();
     m->active = 0;
+    m->drawn_y = 0;
 
     /* Reset previous fire state to avoid suppressed firing when entering demo */
     prev_fire = false;
     
     demo_fire_counter = 0;
     
+#if SPRITE_MUX
+    spritemux_hide(MUX_MISSILE);
+    return;
+#endif
+
     // Set pointer for Sprite 1 (Offset + 1 from Player)
     // Pointer table lives at Screen + 0x3F8 (1016)
     byte* ptrs = (byte*)(Screen + 1016);
@@ -139,56 +213,90 @@ void missile_update(void) {
             // X: Shift 1 pixel left from player position
             m->x = pstate->player_x - 1;
             m->y = 211;
+            m->frac = 0;
+            m->swept_row = MISSILE_ROW_NONE;
         }
         /* Update previous state so subsequent frames require key release */
         prev_fire = input.fire;        
         return;
     }
 
-    // MOVEMENT
-    if (m->y > MISSILE_SPEED + 40) { 
-        m->y -= MISSILE_SPEED;
+#if SPRITE_HW_COLLISION
+    // The latches describe where the missile was shown last frame: if it
+    // touched nothing there, skip the grid tests, otherwise confirm the
+    // contact at that position before moving on.
+    {
+        collision_state* c = collision_get_state();
+        if ((c->sprites | c->background) & COLLIDE_MISSILE) {
+            unsigned int visual_y = m->y + 7;
+            if (check_grid_hit_from_sprite(m->x, visual_y) ||
+                check_grid_hit_from_sprite(m->x, visual_y + 7)) {
+                m->active = 0;
+                return;
+            }
+        }
+    }
+#endif
+
+    // MOVEMENT (speed from the level's curve, see motion.c)
+    unsigned char step = motion_step(&m->frac, motion_get_state()->missile_vy);
+    if (m->y > step + 40) { 
+        m->y -= step;
     } else {
         m->active = 0; 
         return;
     }
 
+#if !SPRITE_HW_COLLISION
     // ROBUST COLLISION DETECTION
-    // We check the "Tip" and the "Body" to prevent tunneling through rows.
-    
-    // The missile art's visible pixels are at offsets 11 and 12 within the sprite.
-    unsigned int visual_y = m->y + 7;
-
-    // Check Tip (Top pixel)
-    if (check_grid_hit_from_sprite(m->x, visual_y)) {
-        m->active = 0;
-        return;
-    }
-
-    // Check Body (length of missle pixels down) to prevent tunnelling
-    if (check_grid_hit_from_sprite(m->x, visual_y + 7)) {
+    // We check the "Tip" and the "Body" to prevent tunneling through rows,
+    // only looking at base cells the missile hasn't swept yet.
+    if (check_grid_swept(m)) {
         m->active = 0;
         return;
     }
+#endif
 }
 
 void missile_render(void) {
     missile_state* m = _mstate();
+#if SPRITE_MUX
     if (m->active) {
-        vic.spr_enable |= 2; // Enable Sprite 1 (Bit 1)
-        
-        vic.spr_pos[1].y = (byte)m->y;
-
-        // X Position & MSB Logic
-        if (m->x > 255) {
-            vic.spr_pos[1].x = (byte)(m->x & 0xFF);
-            vic.spr_msbx |= 2; // Set MSB for Sprite 1 (Bit 1)
-        } else {
-            vic.spr_pos[1].x = (byte)m->x;
-            vic.spr_msbx &= ~2; // Clear MSB for Sprite 1
+        if (!m->drawn_y) {
+            const byte VIC_BANK_BASE_PTR = (byte)(((unsigned)Sprites - 0x4000) >> 6);
+            spritemux_set(MUX_MISSILE, m->x, (byte)m->y, VIC_BANK_BASE_PTR + 1, MISSILE_COLOR, 0);
+        } else if ((byte)m->y != m->drawn_y) {
+            spritemux_move(MUX_MISSILE, m->x, (byte)m->y);
         }
-    } else {
+        m->drawn_y = (byte)m->y;
+    } else if (m->drawn_y) {
+        spritemux_hide(MUX_MISSILE);
+        m->drawn_y = 0;
+    }
+    return;
+#endif
+    // Registers are only written when they change: X once per shot (the
+    // missile flies straight up), Y when the whole-pixel position moves
+    if (m->active) {
+        if (!m->drawn_y) {
+            vic.spr_enable |= 2; // Enable Sprite 1 (Bit 1)
+
+            // X Position & MSB Logic
+            if (m->x > 255) {
+                vic.spr_pos[1].x = (byte)(m->x & 0xFF);
+                vic.spr_msbx |= 2; // Set MSB for Sprite 1 (Bit 1)
+            } else {
+                vic.spr_pos[1].x = (byte)m->x;
+                vic.spr_msbx &= ~2; // Clear MSB for Sprite 1
+            }
+        }
+        if ((byte)m->y != m->drawn_y) {
+            vic.spr_pos[1].y = (byte)m->y;
+            m->drawn_y = (byte)m->y;
+        }
+    } else if (m->drawn_y) {
         vic.spr_enable &= ~2; // Disable Sprite 1
+        m->drawn_y = 0;
     }
 }
 
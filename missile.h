@@ -21,6 +21,9 @@ typedef struct {
 	unsigned char active;
 	unsigned int x;
 	unsigned int y;
+	unsigned char frac;      /* sub-pixel part of y (see motion.h) */
+	unsigned char drawn_y;   /* Y register last written, 0 = sprite off */
+	unsigned char swept_row; /* base cells from this text row down are already tested */
 } missile_state;
 
 // Accessor for missile state
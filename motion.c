@@ -0,0 +1,40 @@
+// © 2026 Christopher G Chandler
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "motion.h"
+
+// --- SPEED CURVES ---
+// One entry per level, 8.8 (0x0120 = 1.125 px/frame); later levels keep the
+// last entry. Level 1 is the original whole-pixel speeds.
+#define MOTION_LEVELS   16
+
+static const fix8 BOMB_VY[MOTION_LEVELS] = {
+    0x0200, 0x0200, 0x0220, 0x0240, 0x0260, 0x0280, 0x02A0, 0x02C0,
+    0x02E0, 0x0300, 0x0300, 0x0340, 0x0340, 0x0380, 0x0380, 0x0380
+};
+
+// Kept below 7 px/frame, the gap between the tip and body tests
+static const fix8 MISSILE_VY[MOTION_LEVELS] = {
+    0x0400, 0x0400, 0x0400, 0x0440, 0x0440, 0x0480, 0x0480, 0x04C0,
+    0x04C0, 0x0500, 0x0500, 0x0500, 0x0500, 0x0500, 0x0500, 0x0500
+};
+
+static const fix8 BONUS_VX[MOTION_LEVELS] = {
+    0x0100, 0x0100, 0x0100, 0x0120, 0x0120, 0x0140, 0x0140, 0x0160,
+    0x0160, 0x0180, 0x0180, 0x0180, 0x0180, 0x0180, 0x0180, 0x0180
+};
+
+static motion_state s_motion_state = { 0x0200, 0x0400, 0x0100 };
+
+void motion_set_level(unsigned char level) {
+    unsigned char n = level ? level - 1 : 0;
+    if (n >= MOTION_LEVELS) n = MOTION_LEVELS - 1;
+
+    s_motion_state.bomb_vy = BOMB_VY[n];
+    s_motion_state.missile_vy = MISSILE_VY[n];
+    s_motion_state.bonus_vx = BONUS_VX[n];
+}
+
+motion_state* motion_get_state(void) {
+    return &s_motion_state;
+}
@@ -0,0 +1,41 @@
+// © 2026 Christopher G Chandler
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#ifndef MOTION_H
+#define MOTION_H
+
+/*
+ * motion.h
+ * Module: Projectile motion
+ * Purpose: 8.8 fixed-point velocities for the sprite bombs, the missile and
+ *          the bonus ship, looked up from per-level speed curves when a
+ *          level starts. Positions stay in whole pixels; each mover keeps
+ *          its sub-pixel fraction in a byte and `motion_step` carries it.
+ * Invariants: Call `motion_set_level` whenever gs->level changes.
+ */
+
+#include "config.h"
+
+typedef unsigned int fix8;      // 8.8: whole pixels in the high byte
+
+// Velocities for the current level (pixels per frame)
+typedef struct {
+	fix8 bomb_vy;
+	fix8 missile_vy;
+	fix8 bonus_vx;
+} motion_state;
+
+void motion_set_level(unsigned char level);
+
+motion_state* motion_get_state(void);
+
+// Whole pixels to move this frame at velocity v. The fraction is added to
+// *frac and its carry is added to the whole part, the same add-with-carry a
+// 6502 would do by hand.
+static inline unsigned char motion_step(unsigned char* frac, fix8 v) {
+    unsigned int f = *frac + (unsigned char)v;
+    *frac = (unsigned char)f;
+    return (unsigned char)(v >> 8) + (unsigned char)(f >> 8);
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include <c64/vic.h>
 #include <c64/types.h>
 #include "player_input.h"
+#include "spritemux.h"
 
 // --- CONFIGURATION ---
 // Sprite pointer base is centralized in config.h as PLAYER_SPRITE_PTR
@@ -48,10 +49,25 @@ void player_die(void) {
     for (int i = 0; i < 60; i++) {
         vic_waitFrame();
         sound_update();         // <--- CRITICAL: Keep sound engine running during pause!
+#if SPRITE_MUX
+        // The render phase is frozen too, so drive the multiplexer here
+        if (i & 1) {
+            player_render();
+        } else {
+            spritemux_hide(MUX_PLAYER);
+        }
+        spritemux_sort();
+        spritemux_update();
+#else
         vic.spr_enable ^= 1;    // Flicker: Toggle Sprite 0 Enable Bit
+#endif
     }
     // Ensure sprite is ON before we continue
+#if SPRITE_MUX
+    player_render();    // shown by the next game_render
+#else
     vic.spr_enable |= 1;
+#endif
 
     // Check Game Over
     if (p->lives == 0) {
@@ -76,6 +92,14 @@ void player_reset_position(void) {
 }
 
 // --- PLAYER MOVEMENT ---
+#if SPRITE_MUX
+void player_init(void) {
+    const byte VIC_BANK_BASE_PTR = (byte)(((unsigned)Sprites - 0x4000) >> 6);
+    player_reset_position();
+    spritemux_set(MUX_PLAYER, _pstate()->player_x, PLAYER_Y_POS,
+                  VIC_BANK_BASE_PTR + 0, VCOL_GREEN, 0);
+}
+#else
 void player_init(void) {
     // Set Sprite Pointer (use runtime bank base computed from `Sprites`)
     byte* screen_ptr_area = (byte*)(Screen + 1016);
@@ -100,6 +124,7 @@ void player_init(void) {
     player_render();
 
 }
+#endif
 
 player_state* player_get_state(void) {
     return &s_player_state;
@@ -128,6 +153,10 @@ void player_update(void) {
 }
 
 void player_render(void) {
+#if SPRITE_MUX
+    spritemux_move(MUX_PLAYER, _pstate()->player_x, PLAYER_Y_POS);
+    return;
+#endif
     vic.spr_pos[0].y = PLAYER_Y_POS;
 
     player_state* p = _pstate();
@@ -0,0 +1,72 @@
+// © 2026 Christopher G Chandler
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "profile.h"
+
+#if PROFILE_ENABLED
+
+#include <c64/vic.h>
+#include <c64/types.h>
+
+// --- CIA 2 TIMER A ---
+// Free for our use: only the KERNAL RS-232 code touches it.
+#define CIA2_TA_LO  (*(volatile unsigned char*)0xDD04)
+#define CIA2_TA_HI  (*(volatile unsigned char*)0xDD05)
+#define CIA2_CRA    (*(volatile unsigned char*)0xDD0E)
+
+#define CRA_START       0x01
+#define CRA_ONE_SHOT    0x08
+#define CRA_FORCE_LOAD  0x10
+
+// Cycles between the timer starting and stopping with no work in between
+#define PROFILE_OVERHEAD  8
+
+#define PROFILE_ROW_OFFSET  (24 * 40 + 14)
+
+static unsigned int peak[PROFILE_SLOTS];
+
+void profile_init(void) {
+    CIA2_CRA = 0;
+    for (unsigned char s = 0; s < PROFILE_SLOTS; s++) {
+        peak[s] = 0;
+    }
+}
+
+void profile_begin(void) {
+    CIA2_TA_LO = 0xFF;
+    CIA2_TA_HI = 0xFF;
+    CIA2_CRA = CRA_FORCE_LOAD | CRA_ONE_SHOT | CRA_START;
+}
+
+void profile_end(unsigned char slot) {
+    // Stop first so the two halves can't tear
+    CIA2_CRA = 0;
+    unsigned int left = CIA2_TA_LO | (CIA2_TA_HI << 8);
+    unsigned int cycles = 0xFFFF - left - PROFILE_OVERHEAD;
+
+    if (cycles > peak[slot]) {
+        peak[slot] = cycles;
+    }
+}
+
+unsigned int profile_peak(unsigned char slot) {
+    return peak[slot];
+}
+
+void profile_draw(void) {
+    unsigned short offset = PROFILE_ROW_OFFSET;
+
+    for (unsigned char s = 0; s < PROFILE_SLOTS; s++) {
+        unsigned int v = peak[s];
+        for (signed char d = 3; d >= 0; d--) {
+            unsigned char n = v & 15;
+            // Screen codes: '0'-'9' are 48-57, 'A'-'F' are 1-6
+            Screen[offset + d] = (n < 10) ? n + 48 : n - 9;
+            Color[offset + d]  = VCOL_WHITE;
+            v >>= 4;
+        }
+        offset += 5;
+    }
+}
+
+#endif
@@ -0,0 +1,43 @@
+// © 2026 Christopher G Chandler
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+/*
+ * profile.h
+ * Module: Cycle counters for the per-frame work
+ * Purpose: Time a section with CIA 2 timer A and keep the worst case per slot.
+ *          Peaks are shown in hex on row 24 (columns 14-33) when
+ *          PROFILE_ENABLED is set (63 cycles = one PAL raster line).
+ *          Interrupts that land inside a section are counted too.
+ */
+
+#include "config.h"
+
+// Measured sections (one readout each on row 24)
+#define PROFILE_ALIENS_UPDATE   0
+#define PROFILE_ALIENS_RENDER   1
+#define PROFILE_SPRITE_SORT     2   // SPRITE_MUX only
+#define PROFILE_SPRITE_UPDATE   3   // SPRITE_MUX only
+#define PROFILE_SLOTS           4
+
+#if PROFILE_ENABLED
+
+void profile_init(void);
+void profile_begin(void);
+void profile_end(unsigned char slot);      // record cycles since profile_begin()
+unsigned int profile_peak(unsigned char slot);
+void profile_draw(void);                   // call from the render phase
+
+#define PROFILE_BEGIN()     profile_begin()
+#define PROFILE_END(slot)   profile_end(slot)
+
+#else
+
+#define PROFILE_BEGIN()
+#define PROFILE_END(slot)
+
+#endif
+
+#endif
@@ -0,0 +1,235 @@
+// © 2026 Christopher G Chandler
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#include "spritemux.h"
+
+#if SPRITE_MUX
+
+#include "profile.h"
+#include <c64/vic.h>
+#include <c64/types.h>
+#include <c64/rasterirq.h>
+#include <stdlib.h>
+
+// --- CONFIGURATION ---
+#define MUX_IRQS            (MUX_SPRITES - 8)
+#define MUX_SPRITE_HEIGHT   21
+#define MUX_IRQ_LEAD        3       // lines from a reuse IRQ to its sprite's top line
+#define MUX_IRQ_GAP         2       // lines between two reuse IRQs
+#define MUX_LAST_LINE       250     // reuse IRQs below this are pointless
+
+// IRQ writes, in order
+#define MUX_W_Y         0
+#define MUX_W_X         1
+#define MUX_W_MSBX      2
+#define MUX_W_EXPAND_X  3
+#define MUX_W_IMAGE     4
+#define MUX_W_COLOR     5
+#define MUX_WRITES      6
+
+static spritemux_state s_mux_state = { 0 };
+
+static inline spritemux_state* _mstate(void) { return &s_mux_state; }
+
+static RIRQCode20 mux_irq[MUX_IRQS];
+static unsigned int hw_free[8];     // first raster line each hardware sprite is done
+
+void spritemux_init(void) {
+    spritemux_state* m = _mstate();
+    byte* ptrs = Screen + 1016;
+
+    for (unsigned char i = 0; i < MUX_SPRITES; i++) {
+        m->order[i] = i;
+    }
+
+    // The addresses that depend on the hardware sprite are patched per frame
+    for (unsigned char i = 0; i < MUX_IRQS; i++) {
+        RIRQCode* c = &mux_irq[i].c;
+        rirq_build(c, MUX_WRITES);
+        rirq_write(c, MUX_W_Y, &vic.spr_pos[0].y, 0);
+        rirq_write(c, MUX_W_X, &vic.spr_pos[0].x, 0);
+        rirq_write(c, MUX_W_MSBX, &vic.spr_msbx, 0);
+        rirq_write(c, MUX_W_EXPAND_X, &vic.spr_expand_x, 0);
+        rirq_write(c, MUX_W_IMAGE, ptrs, 0);
+        rirq_write(c, MUX_W_COLOR, &vic.spr_color[0], 0);
+    }
+
+    vic.spr_multi = 0;
+    vic.spr_expand_y = 0;
+    spritemux_reset();
+}
+
+void spritemux_reset(void) {
+    spritemux_state* m = _mstate();
+    for (unsigned char i = 0; i < MUX_SPRITES; i++) {
+        m->y[i] = MUX_HIDDEN_Y;
+    }
+    for (unsigned char i = 0; i < m->irqs; i++) {
+        rirq_clear(IRQ_SPRITE_MUX_FIRST + i);
+    }
+    rirq_sort();
+    m->irqs = 0;
+    m->dropped = 0;
+    vic.spr_enable = 0;
+}
+
+void spritemux_set(unsigned char id, unsigned int x, unsigned char y,
+                   unsigned char image, unsigned char color, unsigned char flags) {
+    spritemux_state* m = _mstate();
+    m->x[id] = x;
+    m->y[id] = y;
+    m->image[id] = image;
+    m->color[id] = color;
+    m->flags[id] = flags;
+}
+
+void spritemux_move(unsigned char id, unsigned int x, unsigned char y) {
+    spritemux_state* m = _mstate();
+    m->x[id] = x;
+    m->y[id] = y;
+}
+
+void spritemux_image(unsigned char id, unsigned char image) {
+    _mstate()->image[id] = image;
+}
+
+void spritemux_hide(unsigned char id) {
+    _mstate()->y[id] = MUX_HIDDEN_Y;
+}
+
+// Insertion sort of the ids by Y. Objects move a few lines per frame, so
+// last frame's order is nearly right and this is close to one pass.
+// Hidden sprites sort last, where spritemux_update stops.
+void spritemux_sort(void) {
+    spritemux_state* m = _mstate();
+    for (unsigned char i = 1; i < MUX_SPRITES; i++) {
+        unsigned char id = m->order[i];
+        unsigned char y = m->y[id];
+        unsigned char j = i;
+        while (j > 0 && m->y[m->order[j - 1]] > y) {
+            m->order[j] = m->order[j - 1];
+            j--;
+        }
+        m->order[j] = id;
+    }
+}
+
+void spritemux_update(void) {
+    spritemux_state* m = _mstate();
+    byte* ptrs = Screen + 1016;
+    unsigned char enable = 0, msb = 0, expand = 0;
+    unsigned char k = 0;
+
+    // The eight highest sprites go straight into the VIC
+    for (; k < 8; k++) {
+        unsigned char id = m->order[k];
+        unsigned char y = m->y[id];
+        if (y == MUX_HIDDEN_Y) break;
+
+        unsigned char bit = 1 << k;
+        vic.spr_pos[k].x = (unsigned char)m->x[id];
+        vic.spr_pos[k].y = y;
+        if (m->x[id] & 0x100) msb |= bit;
+        if (m->flags[id] & MUX_EXPAND_X) expand |= bit;
+        ptrs[k] = m->image[id];
+        vic.spr_color[k] = m->color[id];
+        enable |= bit;
+        hw_free[k] = y + MUX_SPRITE_HEIGHT;
+    }
+    vic.spr_msbx = msb;
+    vic.spr_expand_x = expand;
+    vic.spr_enable = enable;
+
+    // Every later one takes over the hardware sprite that finishes first,
+    // from an IRQ a few lines above its top. The IRQs fire in this order,
+    // so the MSB and expand bytes can be carried along.
+    unsigned char irq = 0;
+    unsigned int line = 0;
+    m->dropped = 0;
+    for (; k < MUX_SPRITES; k++) {
+        unsigned char id = m->order[k];
+        unsigned char y = m->y[id];
+        if (y == MUX_HIDDEN_Y) break;
+
+        unsigned char h = 0;
+        for (unsigned char i = 1; i < 8; i++) {
+            if (hw_free[i] < hw_free[h]) h = i;
+        }
+
+        unsigned int at = y - MUX_IRQ_LEAD;
+        if (irq && at < line + MUX_IRQ_GAP) at = line + MUX_IRQ_GAP;
+        if (y < MUX_IRQ_LEAD || at < hw_free[h] || at + MUX_IRQ_LEAD > y || at >= MUX_LAST_LINE) {
+            // Too close under the sprites already on this stretch of screen
+            m->dropped++;
+            continue;
+        }
+
+        unsigned char bit = 1 << h;
+        msb &= ~bit;
+        if (m->x[id] & 0x100) msb |= bit;
+        expand &= ~bit;
+        if (m->flags[id] & MUX_EXPAND_X) expand |= bit;
+
+        RIRQCode* c = &mux_irq[irq].c;
+        rirq_addr(c, MUX_W_Y, &vic.spr_pos[h].y);
+        rirq_data(c, MUX_W_Y, y);
+        rirq_addr(c, MUX_W_X, &vic.spr_pos[h].x);
+        rirq_data(c, MUX_W_X, (unsigned char)m->x[id]);
+        rirq_data(c, MUX_W_MSBX, msb);
+        rirq_data(c, MUX_W_EXPAND_X, expand);
+        rirq_addr(c, MUX_W_IMAGE, ptrs + h);
+        rirq_data(c, MUX_W_IMAGE, m->image[id]);
+        rirq_addr(c, MUX_W_COLOR, &vic.spr_color[h]);
+        rirq_data(c, MUX_W_COLOR, m->color[id]);
+        rirq_set(IRQ_SPRITE_MUX_FIRST + irq, (unsigned char)at, c);
+
+        hw_free[h] = y + MUX_SPRITE_HEIGHT;
+        line = at;
+        irq++;
+    }
+
+    for (unsigned char i = irq; i < m->irqs; i++) {
+        rirq_clear(IRQ_SPRITE_MUX_FIRST + i);
+    }
+    m->irqs = irq;
+    rirq_sort();
+}
+
+#if PROFILE_ENABLED
+// Full load: every logical sprite on screen, 12 lines apart so all of them
+// fit. The first sort starts from the reverse order (worst case for the
+// insertion sort); the rest are steady-state frames with a little jitter.
+void spritemux_bench(void) {
+    spritemux_state* m = _mstate();
+
+    for (unsigned char i = 0; i < MUX_SPRITES; i++) {
+        spritemux_set(i, 24 + i * 18, 58 + (MUX_SPRITES - 1 - i) * 12, 0, VCOL_WHITE, 0);
+        m->order[i] = i;
+    }
+    PROFILE_BEGIN();
+    spritemux_sort();
+    PROFILE_END(PROFILE_SPRITE_SORT);
+
+    for (unsigned char f = 0; f < 64; f++) {
+        for (unsigned char i = 0; i < MUX_SPRITES; i++) {
+            m->y[i] = 58 + (MUX_SPRITES - 1 - i) * 12 + ((unsigned char)rand() & 7);
+        }
+        PROFILE_BEGIN();
+        spritemux_sort();
+        PROFILE_END(PROFILE_SPRITE_SORT);
+
+        vic_waitFrame();
+        PROFILE_BEGIN();
+        spritemux_update();
+        PROFILE_END(PROFILE_SPRITE_UPDATE);
+    }
+
+    spritemux_reset();
+}
+#endif
+
+spritemux_state* spritemux_get_state(void) {
+    return &s_mux_state;
+}
+
+#endif
@@ -0,0 +1,73 @@
+// © 2026 Christopher G Chandler
+// Licensed under the MIT License. See LICENSE file in the project root.
+
+#ifndef SPRITEMUX_H
+#define SPRITEMUX_H
+
+/*
+ * spritemux.h
+ * Module: Sprite multiplexer (SPRITE_MUX)
+ * Purpose: Share the 8 hardware sprites between MUX_SPRITES logical sprites.
+ *          Modules set their logical sprite; `spritemux_sort` orders the pool
+ *          by Y and `spritemux_update` loads the top eight into the VIC and
+ *          arms a raster IRQ for each one after that, which takes over the
+ *          hardware sprite that finished highest up the screen.
+ * Invariants: Call `spritemux_sort` and then `spritemux_update` in VBlank,
+ *          after the sprite modules have set their logical sprites and
+ *          before the raster reaches the top sprite.
+ */
+
+#include "config.h"
+
+#define MUX_SPRITES         16
+
+// Logical sprite ids, one per object
+#define MUX_PLAYER          0
+#define MUX_MISSILE         1
+#define MUX_BONUS           2
+#define MUX_SURVIVOR_FIRST  3
+#define MUX_BOMB_FIRST      (MUX_SURVIVOR_FIRST + ALIEN_SPRITE_SURVIVORS)
+
+// spritemux_set flags
+#define MUX_EXPAND_X        0x01
+
+// Y of a hidden logical sprite (sorts after every visible one)
+#define MUX_HIDDEN_Y        0xFF
+
+void spritemux_init(void);
+
+// Hide every logical sprite and disarm the IRQs, e.g. before the intro
+// screen drives the sprites directly.
+void spritemux_reset(void);
+
+// image is the sprite pointer value (block number in the VIC bank)
+void spritemux_set(unsigned char id, unsigned int x, unsigned char y,
+                   unsigned char image, unsigned char color, unsigned char flags);
+void spritemux_move(unsigned char id, unsigned int x, unsigned char y);
+void spritemux_image(unsigned char id, unsigned char image);
+void spritemux_hide(unsigned char id);
+
+void spritemux_sort(void);
+void spritemux_update(void);
+
+#if PROFILE_ENABLED
+// Time spritemux_sort and spritemux_update with the whole pool on screen
+// (PROFILE_SPRITE_SORT / PROFILE_SPRITE_UPDATE), then hide everything.
+void spritemux_bench(void);
+#endif
+
+// Encapsulated multiplexer state
+typedef struct {
+	unsigned int  x[MUX_SPRITES];
+	unsigned char y[MUX_SPRITES];
+	unsigned char image[MUX_SPRITES];
+	unsigned char color[MUX_SPRITES];
+	unsigned char flags[MUX_SPRITES];
+	unsigned char order[MUX_SPRITES];   /* ids by Y (spritemux_sort) */
+	unsigned char irqs;                 /* reuse IRQs armed by the last update */
+	unsigned char dropped;              /* sprites the last update had no room for */
+} spritemux_state;
+
+spritemux_state* spritemux_get_state(void);
+
+#endif
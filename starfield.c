@@ -4,6 +4,9 @@
 #include "starfield.h"
 #include <c64/types.h>
 #include <stdlib.h>   // rand
+#if STARFIELD_ADAPTIVE
+#include <c64/vic.h>
+#endif
 
 extern byte* const Color;
 
@@ -12,9 +15,22 @@ extern byte* const Color;
 #define TOP_ROW     1
 #define BOTTOM_ROW  20
 #define SCREEN_COLS 40
-#define STAR_FRAMES 8
 #define STAR_OFF    32 
 
+// Adaptive density (STARFIELD_ADAPTIVE)
+#define STAR_ADAPT_FRAMES   50  // frames per window (a second at 50Hz)
+#define STAR_ADAPT_STEP     4   // stars added or shed per window
+#define STAR_GROW_LINES     12  // spare lines over the margin to add a step
+
+// CIA 2 timer B times the frame from vic_waitFrame (timer A is profile.c's)
+#define CIA2_TB_LO  (*(volatile unsigned char*)0xDD06)
+#define CIA2_TB_HI  (*(volatile unsigned char*)0xDD07)
+#define CIA2_CRB    (*(volatile unsigned char*)0xDD0F)
+
+#define CRB_START       0x01
+#define CRB_ONE_SHOT    0x08
+#define CRB_FORCE_LOAD  0x10
+
 // Lookup table is now ONLY used in Update (Main Time), not Render (VBlank)
 static const unsigned short row_offsets[26] = {
     0,   40,  80,  120, 160, 200, 240, 280, 320, 360,
@@ -57,6 +73,104 @@ static int is_screen_spot_free(unsigned short pos, byte* screen)
     return 1;
 }
 
+// Give star i a random free spot, phase and colour in `buf`
+static void star_place(starfield_buffer* buf, unsigned char i)
+{
+    // Init Offsets to a safe dummy value
+    buf->pos[i] = 0; 
+
+    // Find a spot
+    for (int k=0; k<50; k++) 
+    {
+        unsigned char r = fast_rand_row();
+        unsigned char c = fast_rand_col();
+        unsigned short p = row_offsets[r] + c;
+        
+        if (is_screen_spot_free(p, Screen)) {
+            buf->pos[i] = p;
+            break;
+        }
+    }
+    
+    unsigned char phase = (unsigned char)rand() & 7; 
+    buf->look[i] = (phase << 4) | star_random_color();
+}
+
+// Erase a star at p (and its tail), only if a star is what's there
+static inline void star_erase(unsigned short p, bool tail, unsigned char star_char_min, unsigned char star_char_max)
+{
+    unsigned char c_on_screen = Screen[p];
+
+    // Check: Is the thing on screen actually a star? 
+    // If it's an Alien (range 128-139), this check fails and we don't erase it.
+    if (c_on_screen >= star_char_min && c_on_screen <= star_char_max) {
+         Screen[p] = STAR_OFF;
+    }
+    
+    // Handle the tail (if it exists)
+    if (tail) {
+         unsigned short p2 = p + SCREEN_COLS;
+         if (p2 < 1000) {
+             c_on_screen = Screen[p2];
+             if (c_on_screen >= star_char_min && c_on_screen <= star_char_max) {
+                Screen[p2] = STAR_OFF;
+             }
+         }
+    }
+}
+
+#if STARFIELD_ADAPTIVE
+// The 9-bit raster line. The low byte and RST8 are separate registers, so
+// read until the low byte is the same either side of RST8.
+static unsigned int star_raster_line(void)
+{
+    unsigned char lo, hi;
+    do {
+        lo = vic.raster;
+        hi = vic.ctrl1 & VIC_CTRL1_RST8;
+    } while (lo != vic.raster);
+    return hi ? 256 + lo : lo;
+}
+
+// Frame and line length of the video standard, from the last raster line:
+// 311 on PAL, 262 on NTSC, 261 on the old NTSC VIC.
+static void star_detect_frame(starfield_state* s)
+{
+    vic_waitFrame();
+    unsigned int last = 256, line;
+    while ((line = star_raster_line()) >= last) last = line;
+
+    if (last >= 300) {
+        s->line_cycles = 63;
+        s->frame_cycles = 312 * 63;
+    } else if (last >= 262) {
+        s->line_cycles = 65;
+        s->frame_cycles = 263 * 65;
+    } else {
+        s->line_cycles = 64;
+        s->frame_cycles = 262 * 64;
+    }
+}
+
+// Erase the stars starfield_frame_done dropped. Runs in VBlank; buf[shown]
+// still holds where they are on screen.
+static void star_erase_dropped(starfield_state* s)
+{
+    const starfield_buffer* cur = &s->buf[s->shown];
+    unsigned char star_char_min = s->char_base;
+    unsigned char star_char_max = s->char_base + STAR_FRAMES;
+    while (s->drawn_stars > s->active_stars) {
+        unsigned char i = --s->drawn_stars;
+#if STARFIELD_CHARSET_ANIM
+        star_erase(cur->pos[i], false, star_char_min, star_char_max);
+#else
+        star_erase(cur->pos[i], cur->look[i] >= ((STAR_FRAMES - 1) << 4), star_char_min, star_char_max);
+#endif
+    }
+    s->drawn_stars = s->active_stars;
+}
+#endif
+
 // --- API ---
 
 void starfield_set_speed(unsigned char frames_per_step)
@@ -72,56 +186,119 @@ void starfield_init(unsigned char char_base_index, unsigned char num_stars)
     s->char_base = char_base_index;
     if (num_stars > MAX_STARS) num_stars = MAX_STARS;
     s->active_stars = num_stars;
-    
+    s->shown = 0;
+    s->moved = false;
+
+#if STARFIELD_CHARSET_ANIM
+    // The phase 7 glyph only has the star's top row; the lower half is in
+    // the tail glyph below it. The render wraps within one cell, so the
+    // phase 7 glyph gets that row at its top.
+    byte* g = Font + (s->char_base + STAR_FRAMES - 1) * 8;
+    g[0] |= g[8];
+#endif
+
+    starfield_buffer* cur = &s->buf[0];
     for (unsigned i = 0; i < s->active_stars; i++)
     {
-        // Init Offsets to a safe dummy value
-        s->next_pos[i] = 0; 
-
-        // Find a spot
-        for (int k=0; k<50; k++) 
-        {
-            unsigned char r = fast_rand_row();
-            unsigned char c = fast_rand_col();
-            unsigned short p = row_offsets[r] + c;
-            
-            if (is_screen_spot_free(p, Screen)) {
-                s->next_pos[i] = p;
-                break;
-            }
+        star_place(cur, i);
+#if STARFIELD_CHARSET_ANIM
+        // The cell is the star's for good: draw it now
+        if (Screen[cur->pos[i]] == STAR_OFF) {
+            Screen[cur->pos[i]] = (unsigned char)(s->char_base + (cur->look[i] >> 4));
+            Color[cur->pos[i]] = cur->look[i];
         }
-        
-        s->next_phase[i] = (unsigned char)rand() & 7; 
-        s->next_color[i] = star_random_color();
-        
-        // Sync State
-        s->curr_pos[i] = s->next_pos[i];
-        s->curr_phase[i] = s->next_phase[i];
-        s->curr_color[i] = s->next_color[i];
+#endif
     }
+#if STARFIELD_CHARSET_ANIM
+    s->repair = 0;
+#endif
+#if STARFIELD_ADAPTIVE
+    s->drawn_stars = num_stars;
+    s->min_spare = 255;
+    s->adapt_frames = 0;
+    s->timing = false;
+    star_detect_frame(s);
+#endif
     
     starfield_render();
 }
 
+#if STARFIELD_CHARSET_ANIM
+// Stars never change cell: a motion step is only a flag for the render.
+void starfield_update_motion()
+{
+    starfield_state* s = _sstate();
+    s->moved = false;
+
+    if (s->speed_delay > 0) {
+        s->speed_counter++;
+        if (s->speed_counter < s->speed_delay) return;
+        s->speed_counter = 0;
+    }
+    s->moved = true;
+}
+
+// Runs in VBlank. A motion step scrolls each phase glyph down a pixel row,
+// the bottom row wrapping to the top: every star falls one pixel through
+// its cell, however many there are. starfield_init copied the tail glyph's
+// top row into the phase 7 glyph, so a star that wraps stays whole and the
+// tail glyph itself is never drawn.
+// Aliens, bombs and the bases blank star cells they pass over, so one star
+// a frame gets its cell back if it is empty.
+void starfield_render()
+{
+    starfield_state* s = _sstate();
+#if STARFIELD_ADAPTIVE
+    star_erase_dropped(s);
+#endif
+
+    if (s->moved) {
+        byte* g = Font + s->char_base * 8;
+        for (unsigned char k = 0; k < STAR_FRAMES; k++, g += 8) {
+            unsigned char b = g[7];
+            g[7] = g[6];
+            g[6] = g[5];
+            g[5] = g[4];
+            g[4] = g[3];
+            g[3] = g[2];
+            g[2] = g[1];
+            g[1] = g[0];
+            g[0] = b;
+        }
+    }
+
+    if (!s->active_stars) return;
+    unsigned char i = s->repair;
+    if (i >= s->active_stars) i = 0;
+    const starfield_buffer* cur = &s->buf[0];
+    unsigned short p = cur->pos[i];
+    if (Screen[p] == STAR_OFF) {
+        unsigned char look = cur->look[i];
+        Screen[p] = (unsigned char)(s->char_base + (look >> 4));
+        Color[p] = look;
+    }
+    if (++i >= s->active_stars) i = 0;
+    s->repair = i;
+}
+#else
 void starfield_update_motion()
 {
-    // STATE COMMIT (Moved from Render to here)
-    // We copy Next -> Curr here, outside of VBlank.
-    // This makes 'curr' the "Old" position (what is currently on screen)
-    // and prepares 'next' to calculate the "New" position.
+    // STATE COMMIT (outside of VBlank)
+    // The step starfield_render drew last frame is what is on screen now:
+    // flip over to its buffer instead of copying Next -> Curr. The other
+    // buffer is then free for the "New" positions.
     starfield_state* s = _sstate();
-    for(unsigned i=0; i<s->active_stars; i++) {
-        s->curr_pos[i]   = s->next_pos[i];
-        s->curr_phase[i] = s->next_phase[i];
-        s->curr_color[i] = s->next_color[i];
+    if (s->moved) {
+        s->shown ^= 1;
+        s->moved = false;
     }
 
     // Speed Check
     if (s->speed_delay > 0) {
         s->speed_counter++;
         if (s->speed_counter < s->speed_delay) {
-            // No movement: Next remains same as Curr.
-            // Render will see (Curr == Next) and skip drawing.
+            // No movement: nothing to commit next frame and nothing for
+            // Render to draw.
             return; 
         }
         s->speed_counter = 0;
@@ -129,11 +306,15 @@ void starfield_update_motion()
 
     // Calculate New Positions
     unsigned short bottom_limit = row_offsets[BOTTOM_ROW] + SCREEN_COLS; // ~920
+    const starfield_buffer* cur = &s->buf[s->shown];
+    starfield_buffer* next = &s->buf[s->shown ^ 1];
 
     for (unsigned i = 0; i < s->active_stars; i++)
     {
-        unsigned char phase = s->curr_phase[i] + 1;
-        unsigned short pos = s->curr_pos[i];
+        unsigned char look = cur->look[i];
+        unsigned char phase = (look >> 4) + 1;
+        unsigned char color = look & 15;
+        unsigned short pos = cur->pos[i];
         
         if (phase >= STAR_FRAMES)
         {
@@ -150,7 +331,7 @@ void starfield_update_motion()
                     
                     if (is_screen_spot_free(p, Screen)) {
                         pos = p;
-                        s->next_color[i] = star_random_color();
+                        color = star_random_color();
                         break;
                     }
                 }
@@ -162,71 +343,123 @@ void starfield_update_motion()
             }
         }
         
-                s->next_phase[i] = phase;
-                s->next_pos[i]   = pos;
+        next->look[i] = (phase << 4) | color;
+        next->pos[i]  = pos;
     }
+    s->moved = true;
 }
 
 // ULTRA-FAST RENDER (Runs in VBlank)
-// No math, no copying, no checks unless necessary.
+// No math, no copying, no checks unless necessary. Every star moves on a
+// motion step and none do otherwise, so one flag says whether to draw.
 void starfield_render()
 {
+    starfield_state* s = _sstate();
+#if STARFIELD_ADAPTIVE
+    star_erase_dropped(s);
+#endif
+    if (!s->moved) return;
+
     // Define the range of characters that belong to stars
     // We only erase if we see one of these.
-    starfield_state* s = _sstate();
     unsigned char star_char_min = s->char_base;
     unsigned char star_char_max = s->char_base + STAR_FRAMES; // Includes tail
+    const starfield_buffer* cur = &s->buf[s->shown];
+    const starfield_buffer* next = &s->buf[s->shown ^ 1];
 
     for (unsigned i = 0; i < s->active_stars; i++)
     {
-        // Optimization: Skip if no change in pos or phase
-        if (s->curr_pos[i] == s->next_pos[i] && s->curr_phase[i] == s->next_phase[i]) continue;
-
         // --- 1. POLITE ERASE (Don't delete Aliens!) ---
-        unsigned short p = s->curr_pos[i];
-        unsigned char c_on_screen = Screen[p];
-
-        // Check: Is the thing on screen actually a star? 
-        // If it's an Alien (range 128-139), this check fails and we don't erase it.
-        if (c_on_screen >= star_char_min && c_on_screen <= star_char_max) {
-             Screen[p] = STAR_OFF;
-        }
-        
-        // Handle the tail (if it exists)
-        if (s->curr_phase[i] == (STAR_FRAMES - 1)) {
-             unsigned short p2 = p + SCREEN_COLS;
-             if (p2 < 1000) {
-                 c_on_screen = Screen[p2];
-                 if (c_on_screen >= star_char_min && c_on_screen <= star_char_max) {
-                    Screen[p2] = STAR_OFF;
-                 }
-             }
-        }
+        unsigned short p = cur->pos[i];
+        star_erase(p, cur->look[i] >= ((STAR_FRAMES - 1) << 4), star_char_min, star_char_max);
 
         // --- 2. POLITE DRAW (Don't overwrite Aliens!) ---
-        p = s->next_pos[i];
+        p = next->pos[i];
         
         // Check: Is the target spot empty?
         // Only draw if it is SPACE (STAR_OFF)
         if (Screen[p] == STAR_OFF) {
-            unsigned char phase = s->next_phase[i];
+            unsigned char look = next->look[i];
             
-            Screen[p] = (unsigned char)(s->char_base + phase);
-            Color[p] = s->next_color[i];
+            Screen[p] = (unsigned char)(s->char_base + (look >> 4));
+            Color[p] = look;
 
             // Tail Draw
-            if (phase == (STAR_FRAMES - 1)) {
+            if (look >= ((STAR_FRAMES - 1) << 4)) {
                 unsigned short p2 = p + SCREEN_COLS;
                 // Check tail spot too!
                 if (p2 < 1000 && Screen[p2] == STAR_OFF) {
                     Screen[p2] = (unsigned char)(s->char_base + STAR_FRAMES);
-                    Color[p2] = s->next_color[i];
+                    Color[p2] = look;
                 }
             }
         }
     }
 }
 
+#endif
+
+#if STARFIELD_ADAPTIVE
+void starfield_frame_start(void)
+{
+    starfield_state* s = _sstate();
+
+    CIA2_TB_LO = 0xFF;
+    CIA2_TB_HI = 0xFF;
+    CIA2_CRB = CRB_FORCE_LOAD | CRB_ONE_SHOT | CRB_START;
+    s->timing = true;
+}
+
+void starfield_frame_done(void)
+{
+    starfield_state* s = _sstate();
+
+    // Only frames starfield_frame_start timed
+    if (!s->timing) return;
+    s->timing = false;
+
+    // Stop first so the two halves can't tear. A one-shot timer clears
+    // START when it runs out: that was a level display or death pause
+    // with its own frame waits, not a frame of work.
+    unsigned char crb = CIA2_CRB;
+    CIA2_CRB = 0;
+    if (!(crb & CRB_START)) return;
+    unsigned int elapsed = 0xFFFF - (CIA2_TB_LO | (CIA2_TB_HI << 8));
+
+    // The timer runs through badlines, so cycles convert straight to the
+    // raster lines left before the next vic_waitFrame returns
+    unsigned char spare = 0;
+    if (elapsed < s->frame_cycles) {
+        unsigned int left = (s->frame_cycles - elapsed) / s->line_cycles;
+        spare = left > 255 ? 255 : (unsigned char)left;
+    }
+    if (spare < s->min_spare) s->min_spare = spare;
+
+    if (++s->adapt_frames < STAR_ADAPT_FRAMES) return;
+    s->adapt_frames = 0;
+
+    // Once a second: the tightest frame decides
+    unsigned char n = s->active_stars;
+    if (s->min_spare < STARFIELD_SPARE_LINES) {
+        // Shed a step; starfield_render erases them
+        s->active_stars = n > STAR_ADAPT_STEP ? n - STAR_ADAPT_STEP : 0;
+    } else if (s->min_spare >= STARFIELD_SPARE_LINES + STAR_GROW_LINES && n < MAX_STARS) {
+        // Add a step. Both buffers get the new stars, so they start from
+        // there whichever one the next update moves them from.
+        unsigned char grown = n + STAR_ADAPT_STEP;
+        if (grown > MAX_STARS) grown = MAX_STARS;
+        for (unsigned char i = n; i < grown; i++) {
+            star_place(&s->buf[s->shown], i);
+            s->buf[s->shown ^ 1].pos[i] = s->buf[s->shown].pos[i];
+            s->buf[s->shown ^ 1].look[i] = s->buf[s->shown].look[i];
+        }
+        if (grown > s->drawn_stars) s->drawn_stars = grown;
+        s->active_stars = grown;
+    }
+    s->min_spare = 255;
+}
+#endif
+
 starfield_state* starfield_get_state(void)
 {
     return &static_starfield_state;
@@ -16,6 +16,7 @@
 
 /* Tunables exposed to callers */
 #define MAX_STARS 50
+#define STAR_FRAMES 8   /* glyphs char_base..char_base+STAR_FRAMES (last is the tail) */
 
 // Initialize with a specific number of stars (max 50)
 void starfield_init(unsigned char char_base_index, unsigned char num_stars);
@@ -26,22 +27,48 @@ void starfield_update_motion();
 void starfield_render();
 void starfield_set_speed(unsigned char frames_per_step);
 
+#if STARFIELD_ADAPTIVE
+// Call as vic_waitFrame returns: starts timing the frame's work.
+void starfield_frame_start(void);
+
+// Call when the frame's logic and render work is done, just before
+// vic_waitFrame: notes the spare raster lines and, once a second, changes
+// the number of stars (see STARFIELD_SPARE_LINES).
+void starfield_frame_done(void);
+#endif
+
+/* One set of star positions. look = phase << 4 | colour, so the render
+ * reads one byte for both; Color RAM only keeps the low nibble.
+ */
+typedef struct {
+	unsigned short pos[MAX_STARS];
+	unsigned char  look[MAX_STARS];
+} starfield_buffer;
+
 /* Encapsulated starfield state (opaque to callers) */
 typedef struct {
 	unsigned char char_base;
 	unsigned char speed_delay;
 	unsigned char speed_counter;
 	unsigned char active_stars;
-	/* Per-star runtime arrays (size `MAX_STARS`).
-	 * These were previously file-local arrays in `starfield.c`.
-	 */
-	unsigned short curr_pos[MAX_STARS];
-	unsigned char  curr_phase[MAX_STARS];
-	unsigned char  curr_color[MAX_STARS];
-
-	unsigned short next_pos[MAX_STARS];
-	unsigned char  next_phase[MAX_STARS];
-	unsigned char  next_color[MAX_STARS];
+	/* buf[shown] is on screen. A motion step writes the other buffer and
+	 * sets `moved`; the next update flips `shown` over to it. With
+	 * STARFIELD_CHARSET_ANIM the stars stay in buf[0] and `moved` asks the
+	 * render to rotate the glyphs. */
+	unsigned char shown;
+	bool          moved;
+#if STARFIELD_CHARSET_ANIM
+	unsigned char repair;   /* next star whose cell the render re-stamps */
+#endif
+#if STARFIELD_ADAPTIVE
+	unsigned char drawn_stars;   /* stars the render may have on screen */
+	unsigned char min_spare;     /* fewest spare lines in this window */
+	unsigned char adapt_frames;  /* frames in this window */
+	bool          timing;        /* starfield_frame_start started the timer */
+	unsigned char line_cycles;   /* of the detected video standard */
+	unsigned int  frame_cycles;
+#endif
+	starfield_buffer buf[2];
 } starfield_state;
 
 /* Getter to obtain pointer to internal state if needed */
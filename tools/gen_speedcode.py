@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+# © 2026 Christopher G Chandler
+# Licensed under the MIT License. See LICENSE file in the project root.
+
+"""
+gen_speedcode.py
+Build step: generate unrolled alien row draw/clear routines for aliens.c.
+
+Reads the alien glyph table (ALIEN_CHARS) and MAX_COLS from aliens.c and
+writes one draw routine per alien type and animation frame, plus one clear
+routine. Every column position is unrolled, so a routine does nothing at
+run time but test the row's mask bits and store constants at fixed offsets
+from the row's screen base. aliens.c uses them when ALIEN_SPEEDCODE is set.
+
+usage: gen_speedcode.py [aliens.c] [aliens_speedcode.h] [col_spacing]
+"""
+
+import re
+import sys
+
+
+def parse_source(path):
+    with open(path, encoding="utf-8") as f:
+        src = f.read()
+
+    m = re.search(r"ALIEN_CHARS\s*\[3\]\s*\[2\]\s*\[2\]\s*=\s*\{(.*?)\};", src, re.S)
+    if not m:
+        sys.exit("gen_speedcode: ALIEN_CHARS not found in " + path)
+    codes = [int(v) for v in re.findall(r"\d+", m.group(1))]
+    if len(codes) != 12:
+        sys.exit("gen_speedcode: ALIEN_CHARS should hold 12 codes")
+    chars = [[codes[t * 4 + f * 2: t * 4 + f * 2 + 2] for f in range(2)] for t in range(3)]
+
+    m = re.search(r"#define\s+MAX_COLS\s+(\d+)", src)
+    if not m:
+        sys.exit("gen_speedcode: MAX_COLS not found in " + path)
+    return chars, int(m.group(1))
+
+
+def mask_tests(cols, body):
+    """Emit one 8-bit mask test per column, low byte first."""
+    out = []
+    for half in range((cols + 7) // 8):
+        out.append("    m = (byte)(mask >> %d);" % (half * 8) if half else "    m = (byte)mask;")
+        for bit in range(min(8, cols - half * 8)):
+            out.append("    if (m & 0x%02X) { %s }" % (1 << bit, body(half * 8 + bit)))
+    return out
+
+
+def generate(chars, cols, spacing):
+    out = [
+        "// Generated by tools/gen_speedcode.py from aliens.c - do not edit.",
+        "// Unrolled row routines for ALIEN_SPEEDCODE: %d columns, column spacing %d." % (cols, spacing),
+        "",
+        "#ifndef ALIENS_SPEEDCODE_H",
+        "#define ALIENS_SPEEDCODE_H",
+        "",
+        "#define SPEEDCODE_COLS        %d" % cols,
+        "#define SPEEDCODE_COL_SPACING %d" % spacing,
+        "",
+        "typedef void (*speed_draw_fn)(byte* p, byte* col, byte color, unsigned int mask);",
+        "",
+    ]
+
+    names = []
+    for t in range(3):
+        row = []
+        for f in range(2):
+            g0, g1 = chars[t][f]
+            name = "speed_draw_%d_%d" % (t, f)
+            row.append(name)
+            out.append("// Type %d, frame %d: glyphs %d/%d" % (t, f, g0, g1))
+            out.append("static void %s(byte* p, byte* col, byte color, unsigned int mask) {" % name)
+            out.append("    byte m;")
+            out += mask_tests(cols, lambda c: "p[%d] = %d; p[%d] = %d; col[%d] = color; col[%d] = color;"
+                              % (c * spacing, g0, c * spacing + 1, g1, c * spacing, c * spacing + 1))
+            out.append("}")
+            out.append("")
+        names.append(row)
+
+    out.append("static void speed_clear(byte* p, unsigned int mask) {")
+    out.append("    byte m;")
+    out += mask_tests(cols, lambda c: "p[%d] = ' '; p[%d] = ' ';" % (c * spacing, c * spacing + 1))
+    out.append("}")
+    out.append("")
+
+    out.append("static speed_draw_fn const SPEED_DRAW[3][2] = {")
+    out.append(",\n".join("    { %s, %s }" % (a, b) for a, b in names))
+    out.append("};")
+    out.append("")
+    out.append("#endif")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    src = sys.argv[1] if len(sys.argv) > 1 else "aliens.c"
+    dst = sys.argv[2] if len(sys.argv) > 2 else "aliens_speedcode.h"
+    spacing = int(sys.argv[3]) if len(sys.argv) > 3 else 3
+
+    chars, cols = parse_source(src)
+    text = generate(chars, cols, spacing)
+    with open(dst, "w", encoding="utf-8", newline="\n") as f:
+        f.write(text)
+
+
+if __name__ == "__main__":
+    main()